@@ -0,0 +1,89 @@
+#ifndef MATH_BATCH_FLOAT_H
+#define MATH_BATCH_FLOAT_H
+
+#include "MathSIMD.h"
+
+// One float per body (or pair) across a SIMD register - 8 lanes with AVX, 4 with SSE, and 1 in the scalar
+// build. Kernels over arrays are written once with these and run MATH_BATCH_WIDTH entries per step,
+// then finish the leftovers one at a time.
+#if MATH_SIMD && defined(__AVX__)
+
+#include <immintrin.h>
+
+// 8 bodies per instruction
+#define MATH_BATCH_WIDTH 8
+typedef __m256 BatchFloat;
+
+static inline BatchFloat batchLoad(const float* dataIn) { return _mm256_loadu_ps(dataIn); };
+static inline void batchStore(float* dataOut, const BatchFloat a) { _mm256_storeu_ps(dataOut, a); };
+static inline BatchFloat batchSet(const float f) { return _mm256_set1_ps(f); };
+static inline BatchFloat batchAdd(const BatchFloat a, const BatchFloat b) { return _mm256_add_ps(a, b); };
+static inline BatchFloat batchSub(const BatchFloat a, const BatchFloat b) { return _mm256_sub_ps(a, b); };
+static inline BatchFloat batchMul(const BatchFloat a, const BatchFloat b) { return _mm256_mul_ps(a, b); };
+static inline BatchFloat batchDiv(const BatchFloat a, const BatchFloat b) { return _mm256_div_ps(a, b); };
+static inline BatchFloat batchSqrt(const BatchFloat a) { return _mm256_sqrt_ps(a); };
+static inline BatchFloat batchLess(const BatchFloat a, const BatchFloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); };
+static inline BatchFloat batchGreater(const BatchFloat a, const BatchFloat b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); };
+static inline BatchFloat batchSelect(const BatchFloat maskIn, const BatchFloat a, const BatchFloat b) { return _mm256_blendv_ps(b, a, maskIn); };
+static inline BatchFloat batchAnd(const BatchFloat a, const BatchFloat b) { return _mm256_and_ps(a, b); };
+static inline BatchFloat batchOr(const BatchFloat a, const BatchFloat b) { return _mm256_or_ps(a, b); };
+static inline int batchMask(const BatchFloat maskIn) { return _mm256_movemask_ps(maskIn); };
+static inline int batchAllSet(const BatchFloat maskIn) { return _mm256_movemask_ps(maskIn) == 0xff; };
+static inline BatchFloat batchAbs(const BatchFloat a) { return _mm256_and_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff))); };
+
+// Lanes 4 * halfIn to 4 * halfIn + 3
+static inline __m128 batchQuarter(const BatchFloat a, const int halfIn)
+{
+	return (halfIn == 0) ? _mm256_castps256_ps128(a) : _mm256_extractf128_ps(a, 1);
+};
+
+// Lanes 0-3 from quartersIn[0] and 4-7 from quartersIn[1]
+static inline BatchFloat batchFromQuarters(const __m128 quartersIn[2])
+{
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(quartersIn[0]), quartersIn[1], 1);
+};
+
+#elif MATH_SIMD
+
+// 4 bodies per instruction
+#define MATH_BATCH_WIDTH 4
+typedef __m128 BatchFloat;
+
+static inline BatchFloat batchLoad(const float* dataIn) { return _mm_loadu_ps(dataIn); };
+static inline void batchStore(float* dataOut, const BatchFloat a) { _mm_storeu_ps(dataOut, a); };
+static inline BatchFloat batchSet(const float f) { return _mm_set1_ps(f); };
+static inline BatchFloat batchAdd(const BatchFloat a, const BatchFloat b) { return _mm_add_ps(a, b); };
+static inline BatchFloat batchSub(const BatchFloat a, const BatchFloat b) { return _mm_sub_ps(a, b); };
+static inline BatchFloat batchMul(const BatchFloat a, const BatchFloat b) { return _mm_mul_ps(a, b); };
+static inline BatchFloat batchDiv(const BatchFloat a, const BatchFloat b) { return _mm_div_ps(a, b); };
+static inline BatchFloat batchSqrt(const BatchFloat a) { return _mm_sqrt_ps(a); };
+static inline BatchFloat batchLess(const BatchFloat a, const BatchFloat b) { return _mm_cmplt_ps(a, b); };
+static inline BatchFloat batchGreater(const BatchFloat a, const BatchFloat b) { return _mm_cmpgt_ps(a, b); };
+static inline BatchFloat batchSelect(const BatchFloat maskIn, const BatchFloat a, const BatchFloat b) { return _mm_or_ps(_mm_and_ps(maskIn, a), _mm_andnot_ps(maskIn, b)); };
+static inline BatchFloat batchAnd(const BatchFloat a, const BatchFloat b) { return _mm_and_ps(a, b); };
+static inline BatchFloat batchOr(const BatchFloat a, const BatchFloat b) { return _mm_or_ps(a, b); };
+static inline int batchMask(const BatchFloat maskIn) { return _mm_movemask_ps(maskIn); };
+static inline int batchAllSet(const BatchFloat maskIn) { return _mm_movemask_ps(maskIn) == 0xf; };
+static inline BatchFloat batchAbs(const BatchFloat a) { return simdAbs(a); };
+
+// Lanes 4 * halfIn to 4 * halfIn + 3 (all of them)
+static inline __m128 batchQuarter(const BatchFloat a, const int halfIn)
+{
+	(void)halfIn;
+	return a;
+};
+
+// All 4 lanes from quartersIn[0]
+static inline BatchFloat batchFromQuarters(const __m128 quartersIn[1])
+{
+	return quartersIn[0];
+};
+
+#else
+
+// Scalar build - every kernel is just its tail loop
+#define MATH_BATCH_WIDTH 1
+
+#endif
+
+#endif
@@ -1,9 +1,13 @@
 #ifndef BLOCK_H
 #define BLOCK_H
 
+#include <assert.h>
 #include "Vect.h"
 #include "Matrix.h"
 #include "Quat.h"
+#include "RigidTransform.h"
+#include "SymMatrix.h"
+#include "BodyStore.h"
 
 // Used to specify corners of the block
 enum MinMax
@@ -15,17 +19,19 @@ enum MinMax
 class Block
 {
 public:
-	// Default constructor
+	// An empty handle, and a handle to one body of a store
 	Block();
+	Block(BodyStore& storeIn, const int bodyIn);
 
-	// Draw the block
+	// Draw the block (defined in BlockDraw.cpp, only built into the demo)
+	// The second version takes the rotation matrix of our current rotation, worked out elsewhere
 	void Draw();
+	void Draw(const Matrix& rotationIn);
 
-	// Update the physics of the block
-	void Update(const float elapsedTime);
-
-	// Calculate the necessary values for collisions each frame
+	// Calculate the necessary values for collisions each frame (transform, bounds, world inertia)
+	// The second version takes the rotation matrix of our current rotation, worked out elsewhere
 	void CalculateDerivedData();
+	void CalculateDerivedData(const Matrix& rotationIn);
 
 	// Calculate the inverse inertial tensor based on mass and box size
 	void CalcInertiaTensor();
@@ -36,30 +42,375 @@ public:
 	// Get a corner of the block in world space
 	Vect GetCorner(const MinMax x, const MinMax y, const MinMax z);
 
-	// Matrices needed for physics, rotation, and collisions
-	Matrix              transformMatrix;
-	Matrix              inverseInertiaTensor;
-	Matrix              inverseInertiaTensorWorld;
+	// Which store and body we're a handle to
+	BodyStore* GetStore() const;
+	int GetBody() const;
+
+	// Rotation and position as of the last CalculateDerivedData, and half our size, used for collisions
+	RigidTransform& Transform();
+	const RigidTransform& Transform() const;
+	Vect HalfSize() const;
+
+	// Our box as of the last CalculateDerivedData, packed for the narrowphase
+	const BodyOBB& OBB() const;
+
+	// Inverse inertia tensors needed for physics (body space, and world space as of the last CalculateDerivedData)
+	SymMatrix& InverseInertiaTensor();
+	const SymMatrix& InverseInertiaTensor() const;
+	SymMatrix& InverseInertiaTensorWorld();
+	const SymMatrix& InverseInertiaTensorWorld() const;
 
 	// Values for our Newton physics - velocity/acceleration/force/etc.
-	Vect                position;
-	Vect                velocity;
-	Vect                acceleration;
-	Quat                rotation;
-	Vect                angVelocity;
-	Vect                angAcceleration;
-	Vect				force;
-	Vect				torque;
+	Vect& Position();
+	const Vect& Position() const;
+	Vect& Velocity();
+	const Vect& Velocity() const;
+	Vect& Acceleration();
+	const Vect& Acceleration() const;
+	Quat& Rotation();
+	const Quat& Rotation() const;
+	Vect& AngVelocity();
+	const Vect& AngVelocity() const;
+	Vect& AngAcceleration();
+	const Vect& AngAcceleration() const;
+	Vect& Force();
+	const Vect& Force() const;
+	Vect& Torque();
+	const Vect& Torque() const;
+
+	// World space bounds (packed), kept up to date with the transform for the broadphases
+	Vect3& BoundsMin();
+	const Vect3& BoundsMin() const;
+	Vect3& BoundsMax();
+	const Vect3& BoundsMax() const;
+	float& BoundingRadius();
+	const float& BoundingRadius() const;
 
 	// Scale and color for drawing
-	Vect				scale;
-	Vect				color;
+	Vect& Scale();
+	const Vect& Scale() const;
+	Vect& Color();
+	const Vect& Color() const;
 
 	// Mass and gravity variables (gravity now and ever let us "sleep" a bit)
-	float               inverseMass;
-	bool				gravityNow;
-	bool				gravityEver;
-	bool				active;
+	float& InverseMass();
+	const float& InverseMass() const;
+	bool& GravityNow();
+	const bool& GravityNow() const;
+	bool& GravityEver();
+	const bool& GravityEver() const;
+	bool& Active();
+	const bool& Active() const;
+
+private:
+	BodyStore*			store;
+	int					body;
+};
+
+// Which store we're a handle to
+inline BodyStore* Block::GetStore() const
+{
+	return store;
+};
+
+// Which body of the store we're a handle to
+inline int Block::GetBody() const
+{
+	return body;
+};
+
+// Transform
+inline RigidTransform& Block::Transform()
+{
+	assert(store != 0);
+	return store->transform[body];
+};
+
+// Transform (constant)
+inline const RigidTransform& Block::Transform() const
+{
+	assert(store != 0);
+	return store->transform[body];
+};
+
+// Half size (constant, set from the scale by CalculateDerivedData)
+inline Vect Block::HalfSize() const
+{
+	assert(store != 0);
+	return store->obb[body].halfSize.getVect();
+};
+
+// Oriented box
+inline const BodyOBB& Block::OBB() const
+{
+	assert(store != 0);
+	return store->obb[body];
+};
+
+// Inverse inertia tensor
+inline SymMatrix& Block::InverseInertiaTensor()
+{
+	assert(store != 0);
+	return store->inverseInertiaTensor[body];
+};
+
+// Inverse inertia tensor (constant)
+inline const SymMatrix& Block::InverseInertiaTensor() const
+{
+	assert(store != 0);
+	return store->inverseInertiaTensor[body];
+};
+
+// Inverse inertia tensor world
+inline SymMatrix& Block::InverseInertiaTensorWorld()
+{
+	assert(store != 0);
+	return store->inverseInertiaTensorWorld[body];
+};
+
+// Inverse inertia tensor world (constant)
+inline const SymMatrix& Block::InverseInertiaTensorWorld() const
+{
+	assert(store != 0);
+	return store->inverseInertiaTensorWorld[body];
+};
+
+// Position
+inline Vect& Block::Position()
+{
+	assert(store != 0);
+	return store->position[body];
+};
+
+// Position (constant)
+inline const Vect& Block::Position() const
+{
+	assert(store != 0);
+	return store->position[body];
+};
+
+// Velocity
+inline Vect& Block::Velocity()
+{
+	assert(store != 0);
+	return store->velocity[body];
+};
+
+// Velocity (constant)
+inline const Vect& Block::Velocity() const
+{
+	assert(store != 0);
+	return store->velocity[body];
+};
+
+// Acceleration
+inline Vect& Block::Acceleration()
+{
+	assert(store != 0);
+	return store->acceleration[body];
+};
+
+// Acceleration (constant)
+inline const Vect& Block::Acceleration() const
+{
+	assert(store != 0);
+	return store->acceleration[body];
+};
+
+// Rotation
+inline Quat& Block::Rotation()
+{
+	assert(store != 0);
+	return store->rotation[body];
+};
+
+// Rotation (constant)
+inline const Quat& Block::Rotation() const
+{
+	assert(store != 0);
+	return store->rotation[body];
+};
+
+// Ang velocity
+inline Vect& Block::AngVelocity()
+{
+	assert(store != 0);
+	return store->angVelocity[body];
+};
+
+// Ang velocity (constant)
+inline const Vect& Block::AngVelocity() const
+{
+	assert(store != 0);
+	return store->angVelocity[body];
+};
+
+// Ang acceleration
+inline Vect& Block::AngAcceleration()
+{
+	assert(store != 0);
+	return store->angAcceleration[body];
+};
+
+// Ang acceleration (constant)
+inline const Vect& Block::AngAcceleration() const
+{
+	assert(store != 0);
+	return store->angAcceleration[body];
+};
+
+// Force
+inline Vect& Block::Force()
+{
+	assert(store != 0);
+	return store->force[body];
+};
+
+// Force (constant)
+inline const Vect& Block::Force() const
+{
+	assert(store != 0);
+	return store->force[body];
+};
+
+// Torque
+inline Vect& Block::Torque()
+{
+	assert(store != 0);
+	return store->torque[body];
+};
+
+// Torque (constant)
+inline const Vect& Block::Torque() const
+{
+	assert(store != 0);
+	return store->torque[body];
+};
+
+// Bounds min
+inline Vect3& Block::BoundsMin()
+{
+	assert(store != 0);
+	return store->bounds[body].min;
+};
+
+// Bounds min (constant)
+inline const Vect3& Block::BoundsMin() const
+{
+	assert(store != 0);
+	return store->bounds[body].min;
+};
+
+// Bounds max
+inline Vect3& Block::BoundsMax()
+{
+	assert(store != 0);
+	return store->bounds[body].max;
+};
+
+// Bounds max (constant)
+inline const Vect3& Block::BoundsMax() const
+{
+	assert(store != 0);
+	return store->bounds[body].max;
+};
+
+// Bounding radius
+inline float& Block::BoundingRadius()
+{
+	assert(store != 0);
+	return store->obb[body].boundingRadius;
+};
+
+// Bounding radius (constant)
+inline const float& Block::BoundingRadius() const
+{
+	assert(store != 0);
+	return store->obb[body].boundingRadius;
+};
+
+// Scale
+inline Vect& Block::Scale()
+{
+	assert(store != 0);
+	return store->scale[body];
+};
+
+// Scale (constant)
+inline const Vect& Block::Scale() const
+{
+	assert(store != 0);
+	return store->scale[body];
+};
+
+// Color
+inline Vect& Block::Color()
+{
+	assert(store != 0);
+	return store->color[body];
+};
+
+// Color (constant)
+inline const Vect& Block::Color() const
+{
+	assert(store != 0);
+	return store->color[body];
+};
+
+// Inverse mass
+inline float& Block::InverseMass()
+{
+	assert(store != 0);
+	return store->inverseMass[body];
+};
+
+// Inverse mass (constant)
+inline const float& Block::InverseMass() const
+{
+	assert(store != 0);
+	return store->inverseMass[body];
+};
+
+// Gravity now
+inline bool& Block::GravityNow()
+{
+	assert(store != 0);
+	return store->flags[body].gravityNow;
+};
+
+// Gravity now (constant)
+inline const bool& Block::GravityNow() const
+{
+	assert(store != 0);
+	return store->flags[body].gravityNow;
+};
+
+// Gravity ever
+inline bool& Block::GravityEver()
+{
+	assert(store != 0);
+	return store->flags[body].gravityEver;
+};
+
+// Gravity ever (constant)
+inline const bool& Block::GravityEver() const
+{
+	assert(store != 0);
+	return store->flags[body].gravityEver;
+};
+
+// Active
+inline bool& Block::Active()
+{
+	assert(store != 0);
+	return store->flags[body].active;
+};
+
+// Active (constant)
+inline const bool& Block::Active() const
+{
+	assert(store != 0);
+	return store->flags[body].active;
 };
 
 
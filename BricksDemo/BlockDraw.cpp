@@ -0,0 +1,38 @@
+#include "Block.h"
+#include "Demo.h"
+
+// Drawing lives apart from Block.cpp so the physics code has no Direct3D dependency
+
+// Draw the block
+void Block::Draw()
+{
+	Matrix Rot;
+	Rot.set(this->Rotation());
+
+	this->Draw(Rot);
+};
+
+// Draw the block, with the rotation matrix for our current rotation already worked out
+void Block::Draw(const Matrix& rotationIn)
+{
+	if (!this->Active()) return;
+
+	// Combine scale with our rotation and translation
+	Matrix Scale;
+	const Vect& scale = this->Scale();
+	Scale.setScale(scale[0], scale[1], scale[2]);
+
+	Matrix Transform = rotationIn;
+	Transform.v[3] = this->Position();
+	Transform.v[3][3] = 1.0f;
+
+	// Also multiply by camera's view matrix to get ModelView matrix
+	Matrix ModelView = Scale * Transform * Demo::GetCamera()->getViewMatrix();
+
+	// Pass the necessary info to demo class, which sends it to shader
+	Demo::SetModelView(ModelView);
+	Demo::SetColorInfo(this->Color());
+
+	// Actual draw call
+	Demo::GetDeviceContext()->DrawIndexed(12 * 3, 0, 0);
+};
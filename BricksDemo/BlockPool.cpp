@@ -0,0 +1,101 @@
+#include "BlockPool.h"
+#include <assert.h>
+
+// Constructor
+BlockPool::BlockPool()
+	:	store(), blocks(0), count(0), capacity(0)
+{
+};
+
+// Destructor
+BlockPool::~BlockPool()
+{
+	delete[] blocks;
+};
+
+// Make room for at least this many blocks (keeps existing blocks)
+void BlockPool::Reserve(const int capacityIn)
+{
+	if (capacityIn <= capacity) return;
+
+	store.Reserve(capacityIn);
+
+	Block* newBlocks = new Block[capacityIn];
+	for (int i = 0; i < count; i++)
+	{
+		newBlocks[i] = blocks[i];
+	}
+
+	delete[] blocks;
+	blocks = newBlocks;
+	capacity = capacityIn;
+};
+
+// Add a block with default values to the end of the pool, growing if necessary
+Block* BlockPool::Add()
+{
+	if (count == capacity)
+	{
+		this->Reserve(capacity > 0 ? capacity * 2 : 16);
+	}
+
+	blocks[count] = Block(store, store.Add());
+	return &blocks[count++];
+};
+
+// Remove all blocks (keeps the memory around for reuse)
+void BlockPool::Clear()
+{
+	store.Clear();
+	count = 0;
+};
+
+// Number of blocks in use
+int BlockPool::Count() const
+{
+	return count;
+};
+
+// Number of blocks we have room for
+int BlockPool::Capacity() const
+{
+	return capacity;
+};
+
+// Indexing for modification
+Block& BlockPool::operator[](const int indexIn)
+{
+	assert(indexIn >= 0 && indexIn < count);
+	return blocks[indexIn];
+};
+
+// Constant indexing
+const Block& BlockPool::operator[](const int indexIn) const
+{
+	assert(indexIn >= 0 && indexIn < count);
+	return blocks[indexIn];
+};
+
+// Raw access for linear iteration
+Block* BlockPool::Data()
+{
+	return blocks;
+};
+
+// Raw access for linear iteration (constant)
+const Block* BlockPool::Data() const
+{
+	return blocks;
+};
+
+// The blocks' data
+BodyStore& BlockPool::Store()
+{
+	return store;
+};
+
+// The blocks' data (constant)
+const BodyStore& BlockPool::Store() const
+{
+	return store;
+};
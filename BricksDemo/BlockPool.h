@@ -0,0 +1,52 @@
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#include "Block.h"
+
+// Contiguous storage for a runtime-chosen number of blocks
+// The blocks' data lives in our BodyStore (block i is body i), the blocks themselves are handles to it
+// Memory only grows in Reserve/Add, which the world calls during setup and never mid-step,
+// so Block pointers (e.g. held by contacts) stay valid for a whole update
+class BlockPool
+{
+public:
+	BlockPool();
+	~BlockPool();
+
+	// Make room for at least this many blocks (keeps existing blocks)
+	void Reserve(const int capacityIn);
+
+	// Add a block with default values to the end of the pool, growing if necessary
+	Block* Add();
+
+	// Remove all blocks (keeps the memory around for reuse)
+	void Clear();
+
+	// Number of blocks in use and number we have room for
+	int Count() const;
+	int Capacity() const;
+
+	// Access blocks by index
+	Block& operator[](const int indexIn);
+	const Block& operator[](const int indexIn) const;
+
+	// Raw access for linear iteration
+	Block* Data();
+	const Block* Data() const;
+
+	// The blocks' data, one array per field, for passes over all of them
+	BodyStore& Store();
+	const BodyStore& Store() const;
+
+private:
+	// Not copyable
+	BlockPool(const BlockPool& poolIn);
+	BlockPool& operator=(const BlockPool& rhs);
+
+	BodyStore					store;
+	Block*						blocks;
+	int							count;
+	int							capacity;
+};
+
+#endif
@@ -0,0 +1,111 @@
+#include <math.h>
+#include "BodyIntegrator.h"
+
+// Constructor
+BodyIntegrator::BodyIntegrator()
+	:	simulated(),
+		spinning(),
+		rotationBatch(),
+		angVelocityX(),
+		angVelocityY(),
+		angVelocityZ(),
+		rotationMatrices()
+{
+};
+
+// Destructor
+BodyIntegrator::~BodyIntegrator()
+{
+};
+
+// Step every body forward, a phase at a time
+void BodyIntegrator::Integrate(BodyStore& storeIn, const float elapsedTime)
+{
+	const int numBodies = storeIn.Count();
+	if (numBodies == 0) return;
+
+	simulated.resize(numBodies);
+	spinning.resize(numBodies);
+	rotationBatch.resize(numBodies);
+	angVelocityX.resize(numBodies);
+	angVelocityY.resize(numBodies);
+	angVelocityZ.resize(numBodies);
+	rotationMatrices.resize(numBodies);
+
+	// The same for every body this step
+	const Vect zero(0.0f, 0.0f, 0.0f);
+	const Vect gravity(0.0f, -100.0f, 0.0f);
+	const float damping = powf(0.5f, elapsedTime);
+
+	// Move the bodies, noting which are simulated (active, finite mass) and which of those are spinning
+	bool anySpinning = false;
+	for (int i = 0; i < numBodies; i++)
+	{
+		BodyFlags& flags = storeIn.flags[i];
+		const bool isSimulated = flags.active & (storeIn.inverseMass[i] > 0.0f);
+		const Vect& velocity = storeIn.velocity[i];
+		const Vect& angVelocity = storeIn.angVelocity[i];
+
+		// Leave gravity off in the beginning until blocks start moving
+		flags.gravityNow = flags.gravityNow | (isSimulated & !velocity.isZero() & flags.gravityEver);
+
+		// Update position using velocity
+		storeIn.position[i] = Vect::select(isSimulated, storeIn.position[i] + (velocity * elapsedTime), storeIn.position[i]);
+
+		const bool isSpinning = isSimulated & !angVelocity.isZero();
+		simulated[i] = (unsigned char)isSimulated;
+		spinning[i] = (float)isSpinning;
+		anySpinning |= isSpinning;
+
+		rotationBatch.set(i, storeIn.rotation[i]);
+		angVelocityX[i] = angVelocity[0];
+		angVelocityY[i] = angVelocity[1];
+		angVelocityZ[i] = angVelocity[2];
+	}
+
+	// Update rotations using angular velocity (bodies that aren't spinning keep theirs)
+	if (anySpinning)
+	{
+		rotationBatch.integrate(&angVelocityX[0], &angVelocityY[0], &angVelocityZ[0], elapsedTime, &spinning[0]);
+	}
+
+	// Velocities, from the forces and torques gathered last step
+	for (int i = 0; i < numBodies; i++)
+	{
+		const bool isSimulated = simulated[i] != 0;
+
+		// Update acceleration, with gravity if it's on
+		Vect acceleration = zero;
+		acceleration += Vect::select(storeIn.flags[i].gravityNow, gravity, zero);
+		acceleration += (storeIn.force[i] * storeIn.inverseMass[i]);
+
+		// Update angular acceleration
+		Vect angAcceleration = zero;
+		angAcceleration += storeIn.torque[i] * storeIn.inverseInertiaTensorWorld[i];
+
+		// Update velocity and angular velocity, and damp them a bit
+		Vect velocity = storeIn.velocity[i];
+		Vect angVelocity = storeIn.angVelocity[i];
+		velocity += (acceleration * elapsedTime);
+		angVelocity += (angAcceleration * elapsedTime);
+		velocity *= damping;
+		angVelocity *= damping;
+
+		// Only simulated bodies take the new values, and have their forces and torques zeroed
+		storeIn.acceleration[i] = Vect::select(isSimulated, acceleration, storeIn.acceleration[i]);
+		storeIn.angAcceleration[i] = Vect::select(isSimulated, angAcceleration, storeIn.angAcceleration[i]);
+		storeIn.velocity[i] = Vect::select(isSimulated, velocity, storeIn.velocity[i]);
+		storeIn.angVelocity[i] = Vect::select(isSimulated, angVelocity, storeIn.angVelocity[i]);
+		storeIn.force[i] = Vect::select(isSimulated, zero, storeIn.force[i]);
+		storeIn.torque[i] = Vect::select(isSimulated, zero, storeIn.torque[i]);
+
+		storeIn.rotation[i] = rotationBatch.get(i);
+	}
+
+	// Rotation matrices for the derived data, all at once
+	rotationBatch.getMatrices(&rotationMatrices[0]);
+	for (int i = 0; i < numBodies; i++)
+	{
+		storeIn.CalculateDerivedData(i, rotationMatrices[i]);
+	}
+};
@@ -0,0 +1,38 @@
+#ifndef BODY_INTEGRATOR_H
+#define BODY_INTEGRATOR_H
+
+#include <vector>
+#include "BodyStore.h"
+#include "QuatBatch.h"
+
+// Steps every body of a store forward in one pass over its arrays, without a branch per body:
+// - the per-step constants (gravity, the damping factor) are worked out once
+// - bodies that aren't simulated (inactive, or infinite mass like the ground) are masked
+//   out of each write, and rotations only move for bodies that are spinning
+// - rotations are integrated and turned into matrices a batch of bodies at a time
+// Each body's update doesn't depend on any other body, so going phase by phase is fine.
+class BodyIntegrator
+{
+public:
+	BodyIntegrator();
+	~BodyIntegrator();
+
+	// Move, rotate and accelerate every body, then work out their derived data
+	void Integrate(BodyStore& storeIn, const float elapsedTime);
+
+private:
+	// Per body masks (1 or 0) - simulated at all, and spinning this step
+	std::vector<unsigned char>	simulated;
+	std::vector<float>			spinning;
+
+	// Rotations and angular velocities, one component per array
+	QuatBatch					rotationBatch;
+	std::vector<float>			angVelocityX;
+	std::vector<float>			angVelocityY;
+	std::vector<float>			angVelocityZ;
+
+	// Rotation matrices for the derived data
+	std::vector<Matrix>			rotationMatrices;
+};
+
+#endif
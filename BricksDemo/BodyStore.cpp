@@ -0,0 +1,135 @@
+#include <math.h>
+#include "BodyStore.h"
+
+// Constructor
+BodyStore::BodyStore()
+	:	position(), velocity(), acceleration(), rotation(), angVelocity(), angAcceleration(), force(), torque(),
+		inverseMass(), flags(), inverseInertiaTensorWorld(), bounds(), obb(), transform(), inverseInertiaTensor(), scale(), color()
+{
+};
+
+// Destructor
+BodyStore::~BodyStore()
+{
+};
+
+// Make room for at least this many bodies (keeps existing bodies)
+void BodyStore::Reserve(const int capacityIn)
+{
+	if (capacityIn <= (int)position.capacity()) return;
+
+	position.reserve(capacityIn);
+	velocity.reserve(capacityIn);
+	acceleration.reserve(capacityIn);
+	rotation.reserve(capacityIn);
+	angVelocity.reserve(capacityIn);
+	angAcceleration.reserve(capacityIn);
+	force.reserve(capacityIn);
+	torque.reserve(capacityIn);
+	inverseMass.reserve(capacityIn);
+	flags.reserve(capacityIn);
+	inverseInertiaTensorWorld.reserve(capacityIn);
+
+	bounds.reserve(capacityIn);
+	obb.reserve(capacityIn);
+	transform.reserve(capacityIn);
+
+	inverseInertiaTensor.reserve(capacityIn);
+	scale.reserve(capacityIn);
+	color.reserve(capacityIn);
+};
+
+// Add a body with the default values, returning its index
+int BodyStore::Add()
+{
+	const BodyFlags defaultFlags = { false, true, true };
+	BodyOBB defaultOBB;
+	defaultOBB.boundingRadius = 0.0f;
+
+	position.push_back(Vect());
+	velocity.push_back(Vect());
+	acceleration.push_back(Vect());
+	rotation.push_back(Quat());
+	angVelocity.push_back(Vect());
+	angAcceleration.push_back(Vect());
+	force.push_back(Vect());
+	torque.push_back(Vect());
+	inverseMass.push_back(0.0f);
+	flags.push_back(defaultFlags);
+	inverseInertiaTensorWorld.push_back(SymMatrix());
+
+	bounds.push_back(AABB());
+	obb.push_back(defaultOBB);
+	transform.push_back(RigidTransform());
+
+	inverseInertiaTensor.push_back(SymMatrix());
+	scale.push_back(Vect(20.0f, 20.0f, 20.0f));
+	color.push_back(Vect(1.0f, 0.0f, 0.0f, 1.0f));
+
+	return (int)position.size() - 1;
+};
+
+// Remove all bodies (keeps the memory around for reuse)
+void BodyStore::Clear()
+{
+	position.clear();
+	velocity.clear();
+	acceleration.clear();
+	rotation.clear();
+	angVelocity.clear();
+	angAcceleration.clear();
+	force.clear();
+	torque.clear();
+	inverseMass.clear();
+	flags.clear();
+	inverseInertiaTensorWorld.clear();
+
+	bounds.clear();
+	obb.clear();
+	transform.clear();
+
+	inverseInertiaTensor.clear();
+	scale.clear();
+	color.clear();
+};
+
+// Number of bodies in use
+int BodyStore::Count() const
+{
+	return (int)position.size();
+};
+
+// Calculate the necessary values for collisions each frame
+void BodyStore::CalculateDerivedData(const int bodyIn, const Matrix& rotationIn)
+{
+	const Vect& bodyPosition = this->position[bodyIn];
+
+	// Our transform is just the rotation and position, no matrix product needed
+	this->transform[bodyIn].set(this->rotation[bodyIn], bodyPosition);
+
+	// The box itself - the rotation matrix rows are our world space axes
+	BodyOBB& box = this->obb[bodyIn];
+	const Vect halfSize = this->scale[bodyIn] * 0.5f;
+	box.center.set(bodyPosition);
+	box.axes[0].set(rotationIn.v[0]);
+	box.axes[1].set(rotationIn.v[1]);
+	box.axes[2].set(rotationIn.v[2]);
+	box.halfSize.set(halfSize);
+	box.boundingRadius = halfSize.mag();
+
+	// World space bounds - project the half size onto each world axis
+	AABB& boxBounds = this->bounds[bodyIn];
+	for (int k = 0; k < 3; k++)
+	{
+		const float extent =
+			halfSize[0] * fabsf(rotationIn.v[0][k]) +
+			halfSize[1] * fabsf(rotationIn.v[1][k]) +
+			halfSize[2] * fabsf(rotationIn.v[2][k]);
+
+		boxBounds.min[k] = bodyPosition[k] - extent;
+		boxBounds.max[k] = bodyPosition[k] + extent;
+	}
+
+	// Transform our inertial tensor into world space
+	this->inverseInertiaTensorWorld[bodyIn] = this->inverseInertiaTensor[bodyIn].getRotated(rotationIn);
+};
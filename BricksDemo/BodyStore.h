@@ -0,0 +1,97 @@
+#ifndef BODY_STORE_H
+#define BODY_STORE_H
+
+#include <vector>
+#include "Vect.h"
+#include "Vect3.h"
+#include "Quat.h"
+#include "RigidTransform.h"
+#include "SymMatrix.h"
+#include "Matrix.h"
+
+// Flags of one body, kept together since they're a byte each
+struct BodyFlags
+{
+	// Gravity now and ever let us "sleep" a bit
+	bool				gravityNow;
+	bool				gravityEver;
+	bool				active;
+};
+
+// World space axis aligned bounding box (packed, the store keeps one per body and the broadphases their own copies)
+struct AABB
+{
+	Vect3 min;
+	Vect3 max;
+};
+
+// Oriented box of one body, worked out once a step by CalculateDerivedData - everything the
+// narrowphase's separating axis tests read, packed into one 64 byte record so a pair costs
+// a cache line per body. Load the fields into Vects (getVect) to do math with them
+struct BodyOBB
+{
+	Vect3				center;
+	Vect3				axes[3];		// World space directions of the local x, y and z (unit length)
+	Vect3				halfSize;
+	float				boundingRadius;
+};
+
+// Physics data for a set of blocks, one contiguous array per field (structure of arrays),
+// so a pass over all the bodies only pulls the fields it uses through the cache.
+// Split by how often it's touched: hot (integrated every step), warm (collision data,
+// derived every step and read by pairs - bounds and OBB by every candidate pair, the
+// transform only by the pairs that touch) and cold (set up once).
+// Block is the handle call sites use to get at one body's fields.
+// Arrays only grow in Reserve/Add, which happen during setup and never mid-step.
+class BodyStore
+{
+public:
+	BodyStore();
+	~BodyStore();
+
+	// Make room for at least this many bodies (keeps existing bodies)
+	void Reserve(const int capacityIn);
+
+	// Add a body with the same defaults Block always had, returning its index
+	int Add();
+
+	// Remove all bodies (keeps the memory around for reuse)
+	void Clear();
+
+	// Number of bodies in use
+	int Count() const;
+
+	// Work out a body's bounds, OBB, transform and world inverse inertia tensor from its
+	// position and rotation, given the rotation as a matrix
+	void CalculateDerivedData(const int bodyIn, const Matrix& rotationIn);
+
+	// Hot - integrated every step
+	std::vector<Vect>			position;
+	std::vector<Vect>			velocity;
+	std::vector<Vect>			acceleration;
+	std::vector<Quat>			rotation;
+	std::vector<Vect>			angVelocity;
+	std::vector<Vect>			angAcceleration;
+	std::vector<Vect>			force;
+	std::vector<Vect>			torque;
+	std::vector<float>			inverseMass;
+	std::vector<BodyFlags>		flags;
+	std::vector<SymMatrix>		inverseInertiaTensorWorld;
+
+	// Warm - derived from the above by CalculateDerivedData
+	std::vector<AABB>			bounds;
+	std::vector<BodyOBB>		obb;
+	std::vector<RigidTransform>	transform;
+
+	// Cold - set up once
+	std::vector<SymMatrix>		inverseInertiaTensor;
+	std::vector<Vect>			scale;
+	std::vector<Vect>			color;
+
+private:
+	// Not copyable (blocks point at us)
+	BodyStore(const BodyStore& storeIn);
+	BodyStore& operator=(const BodyStore& rhs);
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef BROADPHASE_H
+#define BROADPHASE_H
+
+#include "Vect.h"
+#include "Vect3.h"
+#include "Block.h"
+
+// Which broadphase the world uses to find brick pairs that might be colliding
+enum BroadphaseMode
+{
+	BROADPHASE_BRUTE_FORCE,
+	BROADPHASE_SWEEP_AND_PRUNE,
+	BROADPHASE_HASH_GRID,
+	BROADPHASE_AABB_TREE
+};
+
+// Indices of two bricks that might be colliding (one < two)
+struct BlockPair
+{
+	int one;
+	int two;
+};
+
+// Bounds of a body in a store (cached by BodyStore::CalculateDerivedData)
+static inline void CalcBodyAABB(const BodyStore& storeIn, const int bodyIn, AABB& boundsOut)
+{
+	boundsOut = storeIn.bounds[bodyIn];
+};
+
+// Same, through a block
+static inline void CalcBlockAABB(const Block& blockIn, AABB& boundsOut)
+{
+	CalcBodyAABB(*blockIn.GetStore(), blockIn.GetBody(), boundsOut);
+};
+
+// Whether two boxes overlap (touching counts as overlapping)
+static inline bool AABBOverlap(const AABB& one, const AABB& two)
+{
+	return
+		one.min[0] <= two.max[0] && two.min[0] <= one.max[0] &&
+		one.min[1] <= two.max[1] && two.min[1] <= one.max[1] &&
+		one.min[2] <= two.max[2] && two.min[2] <= one.max[2];
+};
+
+// Smallest box holding both boxes
+static inline void AABBCombine(const AABB& one, const AABB& two, AABB& boundsOut)
+{
+	for (int k = 0; k < 3; k++)
+	{
+		boundsOut.min[k] = one.min[k] < two.min[k] ? one.min[k] : two.min[k];
+		boundsOut.max[k] = one.max[k] > two.max[k] ? one.max[k] : two.max[k];
+	}
+};
+
+// Whether the outer box fully contains the inner box
+static inline bool AABBContains(const AABB& outer, const AABB& inner)
+{
+	return
+		outer.min[0] <= inner.min[0] && outer.min[1] <= inner.min[1] && outer.min[2] <= inner.min[2] &&
+		inner.max[0] <= outer.max[0] && inner.max[1] <= outer.max[1] && inner.max[2] <= outer.max[2];
+};
+
+// Surface area of a box (cost metric for building trees)
+static inline float AABBSurfaceArea(const AABB& boundsIn)
+{
+	const float x = boundsIn.max[0] - boundsIn.min[0];
+	const float y = boundsIn.max[1] - boundsIn.min[1];
+	const float z = boundsIn.max[2] - boundsIn.min[2];
+	return 2.0f * (x * y + y * z + z * x);
+};
+
+// Sort pairs into the order the brute force loop visits them
+// Contacts are resolved one after another, so this keeps results the same whichever broadphase ran
+static inline bool BlockPairLess(const BlockPair& a, const BlockPair& b)
+{
+	return a.one < b.one || (a.one == b.one && a.two < b.two);
+};
+
+#endif
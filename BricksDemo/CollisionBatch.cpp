@@ -0,0 +1,165 @@
+#include "CollisionBatch.h"
+#include "BatchFloat.h"
+
+#if MATH_SIMD
+
+// Slack on every test, far above the rounding differences between these tests and CheckColliding's
+// (in either normalize mode or separating axis mode) - a separation has to beat radius * 1.001 + 0.001
+static const float batchRelativeSlack = 1.001f;
+static const float batchAbsoluteSlack = 0.001f;
+
+// Edge pairs closer to parallel than this (1 - R[i][j]^2, their cross product's length squared) are
+// left for CheckColliding, which skips those below 0.0001
+static const float batchParallel = 0.001f;
+
+// Each lane's box as 16 registers, one float of the record each: center (0-2), axes (3-11),
+// half size (12-14) and bounding radius (15). BodyOBB is exactly those 16 floats, so every quarter
+// of 4 records is 4 loads and a transpose
+static inline void batchLoadOBBs(const BodyOBB* const boxesIn[MATH_BATCH_WIDTH], BatchFloat fieldsOut[16])
+{
+	for (int q = 0; q < 4; q++)
+	{
+		__m128 quarters[4][MATH_BATCH_WIDTH / 4];
+		for (int h = 0; h < MATH_BATCH_WIDTH / 4; h++)
+		{
+			__m128 r0 = _mm_loadu_ps((const float*)boxesIn[4 * h] + 4 * q);
+			__m128 r1 = _mm_loadu_ps((const float*)boxesIn[4 * h + 1] + 4 * q);
+			__m128 r2 = _mm_loadu_ps((const float*)boxesIn[4 * h + 2] + 4 * q);
+			__m128 r3 = _mm_loadu_ps((const float*)boxesIn[4 * h + 3] + 4 * q);
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+			quarters[0][h] = r0;
+			quarters[1][h] = r1;
+			quarters[2][h] = r2;
+			quarters[3][h] = r3;
+		}
+
+		for (int k = 0; k < 4; k++)
+		{
+			fieldsOut[4 * q + k] = batchFromQuarters(quarters[k]);
+		}
+	}
+};
+
+// Whether a separation beats the sum of the radii by our margin
+static inline BatchFloat batchBeyond(const BatchFloat distanceIn, const BatchFloat radiusIn)
+{
+	return batchGreater(distanceIn, batchAdd(batchMul(radiusIn, batchSet(batchRelativeSlack)), batchSet(batchAbsoluteSlack)));
+};
+
+// Lanes whose boxes are clearly separated - on bounding spheres, or on any of the 15 axes
+// The axes are read off the relative rotation R = A^T B, as in separatingAxisByRelativeRotation
+static inline BatchFloat batchSeparated(const BatchFloat one[16], const BatchFloat two[16])
+{
+	const BatchFloat dx = batchSub(two[0], one[0]);
+	const BatchFloat dy = batchSub(two[1], one[1]);
+	const BatchFloat dz = batchSub(two[2], one[2]);
+
+	// Bounding spheres
+	const BatchFloat distanceSqr = batchAdd(batchAdd(batchMul(dx, dx), batchMul(dy, dy)), batchMul(dz, dz));
+	const BatchFloat radiusSum = batchAdd(batchMul(batchAdd(one[15], two[15]), batchSet(batchRelativeSlack)), batchSet(batchAbsoluteSlack));
+	BatchFloat separated = batchGreater(distanceSqr, batchMul(radiusSum, radiusSum));
+
+	// Center of two and rotation of two in one's frame
+	BatchFloat t[3];
+	BatchFloat R[3][3];
+	BatchFloat absR[3][3];
+	for (int i = 0; i < 3; i++)
+	{
+		const BatchFloat* axisOne = &one[3 + 3 * i];
+		t[i] = batchAdd(batchAdd(batchMul(dx, axisOne[0]), batchMul(dy, axisOne[1])), batchMul(dz, axisOne[2]));
+
+		for (int j = 0; j < 3; j++)
+		{
+			const BatchFloat* axisTwo = &two[3 + 3 * j];
+			R[i][j] = batchAdd(batchAdd(batchMul(axisOne[0], axisTwo[0]), batchMul(axisOne[1], axisTwo[1])), batchMul(axisOne[2], axisTwo[2]));
+			absR[i][j] = batchAbs(R[i][j]);
+		}
+	}
+
+	const BatchFloat* halfSizeOne = &one[12];
+	const BatchFloat* halfSizeTwo = &two[12];
+
+	// Block one's face axes
+	for (int i = 0; i < 3; i++)
+	{
+		const BatchFloat radiusTwo = batchAdd(batchAdd(batchMul(halfSizeTwo[0], absR[i][0]), batchMul(halfSizeTwo[1], absR[i][1])),
+			batchMul(halfSizeTwo[2], absR[i][2]));
+		separated = batchOr(separated, batchBeyond(batchAbs(t[i]), batchAdd(halfSizeOne[i], radiusTwo)));
+	}
+
+	// Block two's face axes
+	for (int j = 0; j < 3; j++)
+	{
+		const BatchFloat radiusOne = batchAdd(batchAdd(batchMul(halfSizeOne[0], absR[0][j]), batchMul(halfSizeOne[1], absR[1][j])),
+			batchMul(halfSizeOne[2], absR[2][j]));
+		const BatchFloat distance = batchAbs(batchAdd(batchAdd(batchMul(t[0], R[0][j]), batchMul(t[1], R[1][j])), batchMul(t[2], R[2][j])));
+		separated = batchOr(separated, batchBeyond(distance, batchAdd(radiusOne, halfSizeTwo[j])));
+	}
+
+	// Edge pairs, axes one[i] x two[j], unless they're nearly parallel
+	const BatchFloat unit = batchSet(1.0f);
+	for (int i = 0; i < 3; i++)
+	{
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+
+		for (int j = 0; j < 3; j++)
+		{
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+
+			const BatchFloat usable = batchGreater(batchSub(unit, batchMul(R[i][j], R[i][j])), batchSet(batchParallel));
+			const BatchFloat radiusOne = batchAdd(batchMul(halfSizeOne[i1], absR[i2][j]), batchMul(halfSizeOne[i2], absR[i1][j]));
+			const BatchFloat radiusTwo = batchAdd(batchMul(halfSizeTwo[j1], absR[i][j2]), batchMul(halfSizeTwo[j2], absR[i][j1]));
+			const BatchFloat distance = batchAbs(batchSub(batchMul(t[i2], R[i1][j]), batchMul(t[i1], R[i2][j])));
+			separated = batchOr(separated, batchAnd(usable, batchBeyond(distance, batchAdd(radiusOne, radiusTwo))));
+		}
+	}
+
+	return separated;
+};
+
+#endif
+
+// Drop the pairs whose boxes are clearly apart, a batch of pairs at a time
+void RejectSeparatedPairs(const BodyStore& storeIn, const std::vector<BlockPair>& pairsIn, std::vector<BlockPair>& pairsOut)
+{
+	pairsOut.clear();
+	const int numPairs = (int)pairsIn.size();
+	int p = 0;
+
+#if MATH_SIMD
+	const BodyOBB* boxes = storeIn.obb.empty() ? 0 : &storeIn.obb[0];
+
+	for (; p + MATH_BATCH_WIDTH <= numPairs; p += MATH_BATCH_WIDTH)
+	{
+		const BodyOBB* boxesOne[MATH_BATCH_WIDTH];
+		const BodyOBB* boxesTwo[MATH_BATCH_WIDTH];
+		for (int l = 0; l < MATH_BATCH_WIDTH; l++)
+		{
+			boxesOne[l] = &boxes[pairsIn[p + l].one];
+			boxesTwo[l] = &boxes[pairsIn[p + l].two];
+		}
+
+		BatchFloat one[16];
+		BatchFloat two[16];
+		batchLoadOBBs(boxesOne, one);
+		batchLoadOBBs(boxesTwo, two);
+
+		const int separated = batchMask(batchSeparated(one, two));
+		for (int l = 0; l < MATH_BATCH_WIDTH; l++)
+		{
+			if ((separated & (1 << l)) == 0) pairsOut.push_back(pairsIn[p + l]);
+		}
+	}
+#else
+	(void)storeIn;
+#endif
+
+	// Leftovers go through untested, CheckColliding still decides them
+	for (; p < numPairs; p++)
+	{
+		pairsOut.push_back(pairsIn[p]);
+	}
+};
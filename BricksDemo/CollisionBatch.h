@@ -0,0 +1,17 @@
+#ifndef COLLISION_BATCH_H
+#define COLLISION_BATCH_H
+
+#include <vector>
+#include "BodyStore.h"
+#include "Broadphase.h"
+
+// Batched narrowphase rejection - packs the boxes of several pairs into SIMD lanes (8 with AVX, 4 with SSE)
+// and runs the separating axis tests on all of them at once, keeping only the pairs that might touch.
+// Most candidate pairs in a pile of rubble are near misses, so this is where the narrowphase spends its time.
+// It's conservative: a pair is only dropped when it's separated by a clear margin, so CheckColliding
+// (which does the contact generation) rejects every dropped pair too, and running it on what's left gives
+// exactly the same contacts, in the same order, as running it on every pair.
+// Leftover pairs that don't fill a batch, and every pair in the scalar build, are kept for CheckColliding.
+void RejectSeparatedPairs(const BodyStore& storeIn, const std::vector<BlockPair>& pairsIn, std::vector<BlockPair>& pairsOut);
+
+#endif
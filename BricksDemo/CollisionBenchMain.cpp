@@ -0,0 +1,455 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stddef.h>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "World.h"
+#include "PhysicsContact.h"
+#include "CollisionCheck.h"
+#include "CollisionBatch.h"
+#include "BatchFloat.h"
+
+// Block's layout before its data moved into BodyStore (one record per block), for the footprint report
+struct AoSBlock
+{
+	RigidTransform		transform;
+	SymMatrix			inverseInertiaTensor;
+	SymMatrix			inverseInertiaTensorWorld;
+	Vect				position;
+	Vect				velocity;
+	Vect				acceleration;
+	Quat				rotation;
+	Vect				angVelocity;
+	Vect				angAcceleration;
+	Vect				force;
+	Vect				torque;
+	Vect				boundsMin;
+	Vect				boundsMax;
+	float				boundingRadius;
+	Vect				scale;
+	Vect				color;
+	float				inverseMass;
+	bool				gravityNow;
+	bool				gravityEver;
+	bool				active;
+};
+
+// A field a pass touches - which array it's in, where it is in each element, and the element size
+struct FootprintField
+{
+	int					array;
+	size_t				offset;
+	size_t				size;
+	size_t				stride;
+};
+
+#define FOOTPRINT_AOS(field) { 0, offsetof(AoSBlock, field), sizeof(((AoSBlock*)0)->field), sizeof(AoSBlock) }
+#define FOOTPRINT_ARRAY(array, type) { array, 0, sizeof(type), sizeof(type) }
+#define FOOTPRINT_IN(array, type, field) { array, offsetof(type, field), sizeof(((type*)0)->field), sizeof(type) }
+
+// Arrays of the store, for the FootprintField array numbers
+enum FootprintArray
+{
+	FOOTPRINT_POSITION = 1,
+	FOOTPRINT_VELOCITY,
+	FOOTPRINT_ACCELERATION,
+	FOOTPRINT_ROTATION,
+	FOOTPRINT_ANG_VELOCITY,
+	FOOTPRINT_ANG_ACCELERATION,
+	FOOTPRINT_FORCE,
+	FOOTPRINT_TORQUE,
+	FOOTPRINT_INVERSE_MASS,
+	FOOTPRINT_FLAGS,
+	FOOTPRINT_INVERSE_INERTIA_WORLD,
+	FOOTPRINT_BOUNDS,
+	FOOTPRINT_OBB,
+	FOOTPRINT_TRANSFORM,
+	FOOTPRINT_INVERSE_INERTIA,
+	FOOTPRINT_SCALE
+};
+
+// Bytes of cache lines a pass pulls in per body - when it walks every body in order (linearIn),
+// neighbouring bodies share lines, otherwise every body's lines are its own
+static double footprintBytes(const FootprintField* fieldsIn, const int countIn, const bool linearIn)
+{
+	const int lineSize = 64;
+	const int elements = 64;
+	double bytes = 0.0;
+
+	for (int array = 0; array <= FOOTPRINT_SCALE; array++)
+	{
+		std::vector<size_t> lines;
+		for (int e = 0; e < elements; e++)
+		{
+			if (!linearIn) lines.clear();
+
+			for (int f = 0; f < countIn; f++)
+			{
+				const FootprintField& field = fieldsIn[f];
+				if (field.array != array) continue;
+
+				const size_t start = e * field.stride + field.offset;
+				for (size_t line = start / lineSize; line <= (start + field.size - 1) / lineSize; line++)
+				{
+					if (std::find(lines.begin(), lines.end(), line) == lines.end()) lines.push_back(line);
+				}
+			}
+
+			if (!linearIn) bytes += (double)(lines.size() * lineSize) / elements;
+		}
+
+		if (linearIn) bytes += (double)(lines.size() * lineSize) / elements;
+	}
+
+	return bytes;
+};
+
+// Collision path microbenchmark - times CheckColliding on the brick pairs of a knocked down wall
+// and reports how much memory each step of the simulation pulls through the cache
+int main(int argc, char* argv[])
+{
+	int numBricks = 500;
+	int settleSteps = 240;
+	int passes = 200;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const bool hasValue = (i + 1 < argc);
+
+		if (strcmp(argv[i], "--bricks") == 0 && hasValue) numBricks = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--settle") == 0 && hasValue) settleSteps = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--passes") == 0 && hasValue) passes = atoi(argv[++i]);
+		else
+		{
+			fprintf(stderr, "Usage: %s [--bricks N] [--settle STEPS] [--passes N]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (numBricks <= 1 || settleSteps < 0 || passes <= 0)
+	{
+		fprintf(stderr, "Need at least 2 bricks and 1 pass\n");
+		return 1;
+	}
+
+	// Knock the wall down so the pairs cover touching, resting and tumbling bricks
+	World world;
+	world.Reset(numBricks);
+	for (int i = 0; i < settleSteps; i++)
+	{
+		if (i == 30) world.FireBullet(Vect(0.0f, 50.0f, -10.0f), Vect(0.0f, 50.0f, -490.0f));
+		world.Update(1.0f / 60.0f);
+	}
+
+	// Gather the pairs a broadphase would hand to the narrowphase
+	std::vector<BlockPair> pairs;
+	for (int i = 0; i < numBricks; i++)
+	{
+		for (int j = i + 1; j < numBricks; j++)
+		{
+			AABB one, two;
+			CalcBlockAABB(world.bricks[i], one);
+			CalcBlockAABB(world.bricks[j], two);
+			if (AABBOverlap(one, two))
+			{
+				BlockPair pair = { i, j };
+				pairs.push_back(pair);
+			}
+		}
+	}
+
+	if (pairs.empty())
+	{
+		fprintf(stderr, "No overlapping brick pairs to test\n");
+		return 1;
+	}
+
+	// Time CheckColliding over a set of pairs, in one normalize mode and with one separating axis test
+	ContactManifold contact;
+	int hits = 0;
+	const double checks = (double)passes * (double)pairs.size();
+
+	auto timeChecks = [&](const std::vector<BlockPair>& pairsIn, const bool fastIn, const SeparatingAxisMode satIn)
+	{
+		SetCollisionFastNormalize(fastIn);
+		SetCollisionSatMode(satIn);
+		hits = 0;
+
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		for (int pass = 0; pass < passes; pass++)
+		{
+			for (size_t p = 0; p < pairsIn.size(); p++)
+			{
+				if (CheckColliding(world.bricks[pairsIn[p].one], world.bricks[pairsIn[p].two], contact)) hits++;
+				contact.Reset();
+			}
+		}
+
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		SetCollisionFastNormalize(false);
+		SetCollisionSatMode(SAT_PROJECTED_AXES);
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	};
+
+	const double nanoseconds = timeChecks(pairs, false, SAT_PROJECTED_AXES);
+	printf("bricks: %d  pairs: %d  colliding: %d  passes: %d  time: %.3f s  ns/check: %.1f\n",
+		numBricks, (int)pairs.size(), hits / passes, passes, nanoseconds * 1e-9, nanoseconds / checks);
+
+	// How many points the manifolds of the colliding pairs have
+	int pointCounts[MAX_CONTACT_POINTS + 1] = { 0 };
+	for (size_t p = 0; p < pairs.size(); p++)
+	{
+		if (CheckColliding(world.bricks[pairs[p].one], world.bricks[pairs[p].two], contact)) pointCounts[contact.numPoints]++;
+		contact.Reset();
+	}
+	printf("contact points per colliding pair:");
+	for (int n = 1; n <= MAX_CONTACT_POINTS; n++)
+	{
+		printf("  %d: %d", n, pointCounts[n]);
+	}
+	printf("\n");
+
+	// Same pairs with fast normalize mode, and how far its contacts are from the precise ones
+	const double fastNanoseconds = timeChecks(pairs, true, SAT_PROJECTED_AXES);
+	const int fastHits = hits / passes;
+
+	int verdictChanges = 0;
+	float worstPenetration = 0.0f;
+	float worstNormal = 0.0f;
+	for (size_t p = 0; p < pairs.size(); p++)
+	{
+		ContactManifold precise;
+		ContactManifold fast;
+		SetCollisionFastNormalize(false);
+		const bool preciseHit = CheckColliding(world.bricks[pairs[p].one], world.bricks[pairs[p].two], precise);
+		SetCollisionFastNormalize(true);
+		const bool fastHit = CheckColliding(world.bricks[pairs[p].one], world.bricks[pairs[p].two], fast);
+
+		if (preciseHit != fastHit) verdictChanges++;
+		else if (preciseHit)
+		{
+			const float penetrationError = fabsf(fast.penetration - precise.penetration);
+			// Aligned faces can tie, and the face picked decides which block the normal points at
+			const Vect fastNormal = (fast.blocks[0] == precise.blocks[0]) ? fast.normal : fast.normal * -1.0f;
+			const float normalError = (fastNormal - precise.normal).mag();
+			if (penetrationError > worstPenetration) worstPenetration = penetrationError;
+			if (normalError > worstNormal) worstNormal = normalError;
+		}
+	}
+	SetCollisionFastNormalize(false);
+
+	printf("fast normalize: colliding: %d  ns/check: %.1f  verdicts changed: %d  max |pen diff|: %g  max |normal diff|: %g\n",
+		fastHits, fastNanoseconds / checks, verdictChanges, worstPenetration, worstNormal);
+
+	// Same pairs with the relative rotation test, and which of them are near misses - bounds overlapping,
+	// blocks not touching - since those are the pairs it does all the work for
+	const double rotationNanoseconds = timeChecks(pairs, false, SAT_RELATIVE_ROTATION);
+	const int rotationHits = hits / passes;
+
+	std::vector<BlockPair> nearMisses;
+	int rotationVerdictChanges = 0;
+	for (size_t p = 0; p < pairs.size(); p++)
+	{
+		ContactManifold axes;
+		ContactManifold rotation;
+		const bool axesHit = CheckColliding(world.bricks[pairs[p].one], world.bricks[pairs[p].two], axes);
+		SetCollisionSatMode(SAT_RELATIVE_ROTATION);
+		const bool rotationHit = CheckColliding(world.bricks[pairs[p].one], world.bricks[pairs[p].two], rotation);
+		SetCollisionSatMode(SAT_PROJECTED_AXES);
+
+		if (axesHit != rotationHit) rotationVerdictChanges++;
+		if (!axesHit) nearMisses.push_back(pairs[p]);
+	}
+
+	printf("relative rotation: colliding: %d  ns/check: %.1f  verdicts changed: %d\n",
+		rotationHits, rotationNanoseconds / checks, rotationVerdictChanges);
+
+	// The batched rejection in front of CheckColliding, as the world runs it
+	std::vector<BlockPair> keptPairs;
+	auto timeBatched = [&](const std::vector<BlockPair>& pairsIn)
+	{
+		hits = 0;
+
+		const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		for (int pass = 0; pass < passes; pass++)
+		{
+			RejectSeparatedPairs(world.bricks.Store(), pairsIn, keptPairs);
+			for (size_t p = 0; p < keptPairs.size(); p++)
+			{
+				if (CheckColliding(world.bricks[keptPairs[p].one], world.bricks[keptPairs[p].two], contact)) hits++;
+				contact.Reset();
+			}
+		}
+
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	};
+
+	const double batchedNanoseconds = timeBatched(pairs);
+	printf("batched rejection (%d wide): kept: %d  colliding: %d  ns/check: %.1f\n",
+		MATH_BATCH_WIDTH, (int)keptPairs.size(), hits / passes, batchedNanoseconds / checks);
+
+	// The separating axis cache as the world runs it when it's on: pairs still apart on last pass's face axis are
+	// dropped first, then the batched rejection, then CheckColliding, noting each pair's axis for the next pass
+	// The first pass only fills the cache, so it's left out of the timing
+	SeparatingAxisCache axisCache;
+	std::vector<BlockPair> uncachedPairs;
+	auto timeCached = [&](const std::vector<BlockPair>& pairsIn)
+	{
+		axisCache.Reset();
+		hits = 0;
+
+		std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+		for (int pass = 0; pass <= passes; pass++)
+		{
+			if (pass == 1)
+			{
+				hits = 0;
+				start = std::chrono::high_resolution_clock::now();
+			}
+
+			axisCache.BeginStep((int)pairsIn.size());
+			uncachedPairs.clear();
+			for (size_t p = 0; p < pairsIn.size(); p++)
+			{
+				const unsigned int axis = axisCache.Get(pairsIn[p].one, pairsIn[p].two);
+				if (SeparatedOnFaceAxis(world.bricks[pairsIn[p].one], world.bricks[pairsIn[p].two], axis)) axisCache.Set(pairsIn[p].one, pairsIn[p].two, axis);
+				else uncachedPairs.push_back(pairsIn[p]);
+			}
+
+			RejectSeparatedPairs(world.bricks.Store(), uncachedPairs, keptPairs);
+			for (size_t p = 0; p < keptPairs.size(); p++)
+			{
+				unsigned int axis = SAT_NO_AXIS;
+				if (CheckColliding(world.bricks[keptPairs[p].one], world.bricks[keptPairs[p].two], contact, &axis)) hits++;
+				axisCache.Set(keptPairs[p].one, keptPairs[p].two, axis);
+				contact.Reset();
+			}
+		}
+
+		const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+		return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	};
+
+	const double cachedNanoseconds = timeCached(pairs);
+	printf("separating axis cache + batched rejection: colliding: %d  ns/check: %.1f\n", hits / passes, cachedNanoseconds / checks);
+
+	// The pairs the batched rejection keeps are the ones CheckColliding sees - how each test does on those,
+	// with the cached (face) axis each pair had on the pass before
+	RejectSeparatedPairs(world.bricks.Store(), pairs, keptPairs);
+	const std::vector<BlockPair> batchKept = keptPairs;
+	std::vector<unsigned int> keptAxes(batchKept.size(), SAT_NO_AXIS);
+	for (size_t p = 0; p < batchKept.size(); p++)
+	{
+		CheckColliding(world.bricks[batchKept[p].one], world.bricks[batchKept[p].two], contact, &keptAxes[p]);
+		contact.Reset();
+	}
+
+	const double keptChecks = (double)passes * (double)batchKept.size();
+	const double axesKeptNanoseconds = timeChecks(batchKept, false, SAT_PROJECTED_AXES);
+	const double rotationKeptNanoseconds = timeChecks(batchKept, false, SAT_RELATIVE_ROTATION);
+
+	std::vector<unsigned int> axes(keptAxes.size());
+	const std::chrono::high_resolution_clock::time_point keptStart = std::chrono::high_resolution_clock::now();
+	for (int pass = 0; pass < passes; pass++)
+	{
+		axes = keptAxes;
+		for (size_t p = 0; p < batchKept.size(); p++)
+		{
+			CheckColliding(world.bricks[batchKept[p].one], world.bricks[batchKept[p].two], contact, &axes[p]);
+			contact.Reset();
+		}
+	}
+	const std::chrono::high_resolution_clock::time_point keptEnd = std::chrono::high_resolution_clock::now();
+	const double cachedKeptNanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(keptEnd - keptStart).count();
+
+	printf("kept by batched rejection: %d pairs  ns/check: %.1f projected axes -> %.1f relative rotation -> %.1f cached face axis\n",
+		(int)batchKept.size(), axesKeptNanoseconds / keptChecks, rotationKeptNanoseconds / keptChecks, cachedKeptNanoseconds / keptChecks);
+
+	if (!nearMisses.empty())
+	{
+		const double missChecks = (double)passes * (double)nearMisses.size();
+		const double axesMissNanoseconds = timeChecks(nearMisses, false, SAT_PROJECTED_AXES);
+		const double rotationMissNanoseconds = timeChecks(nearMisses, false, SAT_RELATIVE_ROTATION);
+		const double batchedMissNanoseconds = timeBatched(nearMisses);
+		const double cachedMissNanoseconds = timeCached(nearMisses);
+		printf("near misses: %d pairs  ns/check: %.1f projected axes -> %.1f relative rotation -> %.1f batched -> %.1f cached axis + batched\n",
+			(int)nearMisses.size(), axesMissNanoseconds / missChecks, rotationMissNanoseconds / missChecks,
+			batchedMissNanoseconds / missChecks, cachedMissNanoseconds / missChecks);
+	}
+
+	// Memory each pass of a step touches, with one record per block against the hot/warm/cold store
+	// Integration, derived data and broadphase walk the bricks in order, the narrowphase hops between pairs
+	const FootprintField aosIntegrate[] = { FOOTPRINT_AOS(position), FOOTPRINT_AOS(velocity), FOOTPRINT_AOS(acceleration),
+		FOOTPRINT_AOS(rotation), FOOTPRINT_AOS(angVelocity), FOOTPRINT_AOS(angAcceleration), FOOTPRINT_AOS(force),
+		FOOTPRINT_AOS(torque), FOOTPRINT_AOS(inverseMass), FOOTPRINT_AOS(gravityNow), FOOTPRINT_AOS(gravityEver),
+		FOOTPRINT_AOS(active), FOOTPRINT_AOS(inverseInertiaTensorWorld) };
+	const FootprintField storeIntegrate[] = { FOOTPRINT_ARRAY(FOOTPRINT_POSITION, Vect), FOOTPRINT_ARRAY(FOOTPRINT_VELOCITY, Vect),
+		FOOTPRINT_ARRAY(FOOTPRINT_ACCELERATION, Vect), FOOTPRINT_ARRAY(FOOTPRINT_ROTATION, Quat),
+		FOOTPRINT_ARRAY(FOOTPRINT_ANG_VELOCITY, Vect), FOOTPRINT_ARRAY(FOOTPRINT_ANG_ACCELERATION, Vect),
+		FOOTPRINT_ARRAY(FOOTPRINT_FORCE, Vect), FOOTPRINT_ARRAY(FOOTPRINT_TORQUE, Vect),
+		FOOTPRINT_ARRAY(FOOTPRINT_INVERSE_MASS, float), FOOTPRINT_ARRAY(FOOTPRINT_FLAGS, BodyFlags),
+		FOOTPRINT_ARRAY(FOOTPRINT_INVERSE_INERTIA_WORLD, SymMatrix) };
+
+	const FootprintField aosDerived[] = { FOOTPRINT_AOS(rotation), FOOTPRINT_AOS(position), FOOTPRINT_AOS(scale),
+		FOOTPRINT_AOS(inverseInertiaTensor), FOOTPRINT_AOS(transform), FOOTPRINT_AOS(boundsMin), FOOTPRINT_AOS(boundsMax),
+		FOOTPRINT_AOS(boundingRadius), FOOTPRINT_AOS(inverseInertiaTensorWorld) };
+	const FootprintField storeDerived[] = { FOOTPRINT_ARRAY(FOOTPRINT_ROTATION, Quat), FOOTPRINT_ARRAY(FOOTPRINT_POSITION, Vect),
+		FOOTPRINT_ARRAY(FOOTPRINT_SCALE, Vect), FOOTPRINT_ARRAY(FOOTPRINT_INVERSE_INERTIA, SymMatrix),
+		FOOTPRINT_ARRAY(FOOTPRINT_BOUNDS, AABB), FOOTPRINT_ARRAY(FOOTPRINT_OBB, BodyOBB),
+		FOOTPRINT_ARRAY(FOOTPRINT_TRANSFORM, RigidTransform), FOOTPRINT_ARRAY(FOOTPRINT_INVERSE_INERTIA_WORLD, SymMatrix) };
+
+	const FootprintField aosBroadphase[] = { FOOTPRINT_AOS(active), FOOTPRINT_AOS(boundsMin), FOOTPRINT_AOS(boundsMax) };
+	const FootprintField storeBroadphase[] = { FOOTPRINT_IN(FOOTPRINT_FLAGS, BodyFlags, active),
+		FOOTPRINT_ARRAY(FOOTPRINT_BOUNDS, AABB) };
+
+	const FootprintField aosNarrowphase[] = { FOOTPRINT_AOS(active), FOOTPRINT_AOS(boundsMin), FOOTPRINT_AOS(boundsMax),
+		FOOTPRINT_AOS(boundingRadius), FOOTPRINT_AOS(transform), FOOTPRINT_AOS(scale) };
+	const FootprintField storeNarrowphase[] = { FOOTPRINT_IN(FOOTPRINT_FLAGS, BodyFlags, active),
+		FOOTPRINT_ARRAY(FOOTPRINT_OBB, BodyOBB) };
+
+	struct FootprintPass
+	{
+		const char* name;
+		const FootprintField* aosFields;
+		int aosCount;
+		const FootprintField* storeFields;
+		int storeCount;
+		bool linear;
+		double perStep;
+	};
+
+	const double numPairs = (double)pairs.size();
+	const FootprintPass footprintPasses[] =
+	{
+		{ "integrate", aosIntegrate, 13, storeIntegrate, 11, true, (double)numBricks },
+		{ "derived data", aosDerived, 9, storeDerived, 8, true, (double)numBricks },
+		{ "broadphase", aosBroadphase, 3, storeBroadphase, 2, true, (double)numBricks },
+		{ "narrowphase", aosNarrowphase, 6, storeNarrowphase, 2, false, 2.0 * numPairs }
+	};
+
+	printf("memory touched per step: %d byte Block records -> hot/warm/cold store (%d byte OBB records)\n",
+		(int)sizeof(AoSBlock), (int)sizeof(BodyOBB));
+
+	double totalBefore = 0.0;
+	double totalAfter = 0.0;
+	for (int p = 0; p < 4; p++)
+	{
+		const FootprintPass& pass = footprintPasses[p];
+		const double before = footprintBytes(pass.aosFields, pass.aosCount, pass.linear);
+		const double after = footprintBytes(pass.storeFields, pass.storeCount, pass.linear);
+		totalBefore += before * pass.perStep;
+		totalAfter += after * pass.perStep;
+
+		printf("  %-14s %6.1f -> %6.1f bytes per body  (%.0f bodies per step)\n", pass.name, before, after, pass.perStep);
+	}
+	printf("  %-14s %6.1f -> %6.1f KB per step\n", "total", totalBefore / 1024.0, totalAfter / 1024.0);
+
+	return 0;
+};
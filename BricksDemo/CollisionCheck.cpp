@@ -5,199 +5,444 @@
 #include <float.h>
 #include <assert.h>
 
-// Fill in data for a point to face collision
+// Clip a convex polygon to the side of a plane where planeNormal . p <= planeOffset
+// Returns the number of points left (one more than we started with at most)
+static int clipPolygon(
+	const Vect* polygonIn,
+	const int numIn,
+	const Vect& planeNormal,
+	const float planeOffset,
+	Vect* polygonOut)
+{
+	int numOut = 0;
+	for (int i = 0; i < numIn; i++)
+	{
+		const Vect& start = polygonIn[i];
+		const Vect& end = polygonIn[(i + 1) % numIn];
+		const float startDistance = planeNormal.dot(start) - planeOffset;
+		const float endDistance = planeNormal.dot(end) - planeOffset;
+
+		// Keep the points inside, and add one where an edge crosses the plane
+		if (startDistance <= 0.0f) polygonOut[numOut++] = start;
+		if ((startDistance < 0.0f && endDistance > 0.0f) || (startDistance > 0.0f && endDistance < 0.0f))
+		{
+			polygonOut[numOut++] = start + (end - start) * (startDistance / (startDistance - endDistance));
+		}
+	}
+	return numOut;
+};
+
+// Contact points for box two resting on a face of box one - clip box two's face that faces box one
+// against the sides of box one's face, and keep the points that are below it
+// Cuts them down to 4 (deepest, farthest from it, then the widest on each side) and returns how many
+static int clipFaceContacts(
+	const BodyOBB& boxOne,
+	const BodyOBB& boxTwo,
+	const unsigned int best,
+	const Vect& normal,
+	Vect pointsOut[MAX_CONTACT_POINTS],
+	float penetrationsOut[MAX_CONTACT_POINTS])
+{
+	Vect axesOne[3];
+	Vect axesTwo[3];
+	loadOBBAxes(boxOne, axesOne);
+	loadOBBAxes(boxTwo, axesTwo);
+	const Vect centerOne = boxOne.center.getVect();
+	const Vect centerTwo = boxTwo.center.getVect();
+	const Vect halfSizeOne = boxOne.halfSize.getVect();
+	const Vect halfSizeTwo = boxTwo.halfSize.getVect();
+
+	// Box two's face most in line with the normal (the normal points from two to one)
+	unsigned int faceTwo = 0;
+	float bestAlignment = -1.0f;
+	for (unsigned int k = 0; k < 3; k++)
+	{
+		const float alignment = fabsf(axesTwo[k].dot(normal));
+		if (alignment > bestAlignment)
+		{
+			bestAlignment = alignment;
+			faceTwo = k;
+		}
+	}
+	Vect faceNormal = axesTwo[faceTwo];
+	if (faceNormal.dot(normal) < 0.0f) faceNormal = faceNormal * -1.0f;
+
+	// Its corners
+	const Vect faceCenter = centerTwo + faceNormal * halfSizeTwo[faceTwo];
+	const Vect sideOne = axesTwo[(faceTwo + 1) % 3] * halfSizeTwo[(faceTwo + 1) % 3];
+	const Vect sideTwo = axesTwo[(faceTwo + 2) % 3] * halfSizeTwo[(faceTwo + 2) % 3];
+
+	Vect polygon[8];
+	Vect clipped[8];
+	int numPolygon = 4;
+	polygon[0] = faceCenter + sideOne + sideTwo;
+	polygon[1] = faceCenter - sideOne + sideTwo;
+	polygon[2] = faceCenter - sideOne - sideTwo;
+	polygon[3] = faceCenter + sideOne - sideTwo;
+
+	// Clip to the 4 sides of box one's face
+	for (unsigned int side = 1; side < 3; side++)
+	{
+		const unsigned int k = (best + side) % 3;
+		for (int sign = -1; sign <= 1; sign += 2)
+		{
+			const Vect planeNormal = axesOne[k] * (float)sign;
+			numPolygon = clipPolygon(polygon, numPolygon, planeNormal, planeNormal.dot(centerOne) + halfSizeOne[k], clipped);
+			if (numPolygon == 0) return 0;
+
+			for (int i = 0; i < numPolygon; i++) polygon[i] = clipped[i];
+		}
+	}
+
+	// Keep the points below box one's face (it faces box two, against the normal)
+	const float faceOffset = halfSizeOne[best] - normal.dot(centerOne);
+	float penetrations[8];
+	int numInside = 0;
+	for (int i = 0; i < numPolygon; i++)
+	{
+		const float penetration = faceOffset + normal.dot(polygon[i]);
+		if (penetration > 0.0f)
+		{
+			polygon[numInside] = polygon[i];
+			penetrations[numInside] = penetration;
+			numInside++;
+		}
+	}
+	if (numInside == 0) return 0;
+
+	// Deepest point first
+	int picked[MAX_CONTACT_POINTS];
+	picked[0] = 0;
+	for (int i = 1; i < numInside; i++)
+	{
+		if (penetrations[i] > penetrations[picked[0]]) picked[0] = i;
+	}
+
+	int numPicked = 1;
+	if (numInside <= MAX_CONTACT_POINTS)
+	{
+		// Few enough to keep them all
+		for (int i = 0; i < numInside; i++)
+		{
+			if (i != picked[0]) picked[numPicked++] = i;
+		}
+	}
+	else
+	{
+		// The point farthest from the deepest one
+		int farthest = picked[0];
+		float farthestSqr = 0.0f;
+		for (int i = 0; i < numInside; i++)
+		{
+			const float distanceSqr = (polygon[i] - polygon[picked[0]]).magSqr();
+			if (distanceSqr > farthestSqr)
+			{
+				farthestSqr = distanceSqr;
+				farthest = i;
+			}
+		}
+
+		// Then the points making the biggest triangle with those two, one on each side of the line between them
+		if (farthest != picked[0])
+		{
+			picked[numPicked++] = farthest;
+
+			const Vect line = polygon[farthest] - polygon[picked[0]];
+			int widest[2] = { -1, -1 };
+			float widestArea[2] = { 0.0f, 0.0f };
+			for (int i = 0; i < numInside; i++)
+			{
+				const float area = line.cross(polygon[i] - polygon[picked[0]]).dot(normal);
+				if (area > widestArea[0]) { widestArea[0] = area; widest[0] = i; }
+				if (area < -widestArea[1]) { widestArea[1] = -area; widest[1] = i; }
+			}
+			if (widest[0] >= 0) picked[numPicked++] = widest[0];
+			if (widest[1] >= 0) picked[numPicked++] = widest[1];
+		}
+	}
+
+	for (int i = 0; i < numPicked; i++)
+	{
+		pointsOut[i] = polygon[picked[i]];
+		penetrationsOut[i] = penetrations[picked[i]];
+	}
+	return numPicked;
+};
+
+// Fill in data for a face collision
 void fillContactPointFaceCollision(
 	 Block& blockOne,
 	 Block& blockTwo,
 	const Vect& toCenter,
-	PhysicsContact& pContact,
+	ContactManifold& manifold,
 	unsigned int best,
 	float penetration)
 {
-	// If this is called, we know vertex from two is in contact with one
-	Matrix transOne = blockOne.transformMatrix;
-	Matrix transTwo = blockTwo.transformMatrix;
+	// If this is called, we know box two is in contact with a face of one
+	Vect axesOne[3];
+	Vect axesTwo[3];
+	loadOBBAxes(blockOne.OBB(), axesOne);
+	loadOBBAxes(blockTwo.OBB(), axesTwo);
 
 	// We know the axis of the collision
 	// Could be either of 2 faces
 	Vect normal;
 	if (best == 0)
 	{
-		normal = transOne.v0;
+		normal = axesOne[0];
 	}
 	else if (best == 1)
 	{
-		normal = transOne.v1;
+		normal = axesOne[1];
 	}
 	else
 	{
-		normal = transOne.v2;
+		normal = axesOne[2];
 	}
 	if (normal.dot(toCenter) > 0.0f)
 	{
 		normal = normal * -1.0f;
 	}
 
-	// Work out which vertex of box two we're colliding with.
-	Vect vertex = blockTwo.scale * 0.5f;
-	if (transTwo.v0.dot(normal) < 0) vertex[0] = -vertex[0];
-	if (transTwo.v1.dot(normal) < 0) vertex[1] = -vertex[1];
-	if (transTwo.v2.dot(normal) < 0) vertex[2] = -vertex[2];
-
 	// Now fill in the contact data
-	pContact.normal = normal;
-	pContact.penetration = penetration;
-	pContact.contactPoint = vertex * transTwo;
-	pContact.blocks[0] = &blockOne;
-	pContact.blocks[1] = &blockTwo;
+	manifold.normal = normal;
+	manifold.penetration = penetration;
+	manifold.blocks[0] = &blockOne;
+	manifold.blocks[1] = &blockTwo;
+
+	// The whole area they touch on, if clipping finds any of it
+	manifold.numPoints = clipFaceContacts(blockOne.OBB(), blockTwo.OBB(), best, normal, manifold.points, manifold.penetrations);
+	if (manifold.numPoints > 0) return;
+
+	// Otherwise just the vertex of box two we're colliding with
+	Vect vertex = blockTwo.HalfSize();
+	if (axesTwo[0].dot(normal) < 0) vertex[0] = -vertex[0];
+	if (axesTwo[1].dot(normal) < 0) vertex[1] = -vertex[1];
+	if (axesTwo[2].dot(normal) < 0) vertex[2] = -vertex[2];
+
+	manifold.numPoints = 1;
+	manifold.points[0] = blockTwo.Transform().transformPoint(vertex);
+	manifold.penetrations[0] = penetration;
+};
+
+
+// Build time default for fast normalize mode
+#ifndef COLLISION_FAST_NORMALIZE
+#define COLLISION_FAST_NORMALIZE 0
+#endif
+
+static bool collisionFastNormalize = (COLLISION_FAST_NORMALIZE != 0);
+
+// Turn fast normalize mode on or off
+void SetCollisionFastNormalize(const bool fastIn)
+{
+	collisionFastNormalize = fastIn;
+};
+
+// Whether fast normalize mode is on
+bool GetCollisionFastNormalize()
+{
+	return collisionFastNormalize;
+};
+
+static SeparatingAxisMode collisionSatMode = SAT_PROJECTED_AXES;
+
+// Pick the separating axis test
+void SetCollisionSatMode(const SeparatingAxisMode modeIn)
+{
+	collisionSatMode = modeIn;
 };
 
+// Which separating axis test we use
+SeparatingAxisMode GetCollisionSatMode()
+{
+	return collisionSatMode;
+};
 
-// Macro to test a given axis
+// Macros to test a given axis (normalizing it first, or already unit length)
 // Updates the smallest penetration if necessary
-// Returns if this axis shows we're not colliding
+// Returns if this axis shows we're not colliding (remembering it as the separating axis)
 #define TEST_AXIS(axis, index) \
-	if ( !testAxis(blockOne, blockTwo, (axis), diffCenter, (index), penetration, bestIndex)) return 0;
+	if ( !testAxis(halfSizeOne, axesOne, halfSizeTwo, axesTwo, (axis), diffCenter, (index), fastNormalize, penetration, bestIndex)) \
+	{ \
+		if (cachedAxisInOut) *cachedAxisInOut = (index); \
+		return 0; \
+	}
+#define TEST_UNIT_AXIS(axis, index) \
+	if ( !testUnitAxis(halfSizeOne, axesOne, halfSizeTwo, axesTwo, (axis), diffCenter, (index), penetration, bestIndex)) \
+	{ \
+		if (cachedAxisInOut) *cachedAxisInOut = (index); \
+		return 0; \
+	}
+
+// Whether a face axis (0-5, numbered like CheckColliding's) separates two blocks
+// Tested exactly as the full search does, so it agrees with it. Edge axes would need a cross product
+// built and normalized, which costs about as much as rejecting on the relative rotation, so they're left out
+static inline bool separatedOnFaceAxis(
+	const Vect& halfSizeOne,
+	const Vect axesOne[3],
+	const Vect& halfSizeTwo,
+	const Vect axesTwo[3],
+	const Vect& diffCenter,
+	const unsigned int index,
+	const bool fastNormalize)
+{
+	if (index >= 6) return false;
+
+	Vect axis = (index < 3) ? axesOne[index] : axesTwo[index - 3];
+	float penetration = FLT_MAX;
+	unsigned bestIndex = SAT_NO_AXIS;
+	return !testAxis(halfSizeOne, axesOne, halfSizeTwo, axesTwo, axis, diffCenter, index, fastNormalize, penetration, bestIndex);
+};
 
-bool CheckColliding(Block& blockOne, Block& blockTwo, PhysicsContact& contact)
+// Whether a face axis still separates two blocks, straight from their packed boxes
+bool SeparatedOnFaceAxis(Block& blockOne, Block& blockTwo, const unsigned int axisIn)
 {
-	if (!blockOne.active || !blockTwo.active) return false;
+	if (axisIn >= 6) return false;
+
+	const BodyOBB& boxOne = blockOne.OBB();
+	const BodyOBB& boxTwo = blockTwo.OBB();
+	Vect axesOne[3];
+	Vect axesTwo[3];
+	loadOBBAxes(boxOne, axesOne);
+	loadOBBAxes(boxTwo, axesTwo);
+	const Vect diffCenter = boxTwo.center.getVect() - boxOne.center.getVect();
+
+	return separatedOnFaceAxis(boxOne.halfSize.getVect(), axesOne, boxTwo.halfSize.getVect(), axesTwo, diffCenter,
+		axisIn, collisionFastNormalize);
+};
+
+bool CheckColliding(Block& blockOne, Block& blockTwo, ContactManifold& manifold, unsigned int* cachedAxisInOut /*= 0*/)
+{
+	if (!blockOne.Active() || !blockTwo.Active()) return false;
+
+	// Everything from here until we know the blocks touch comes from their packed boxes
+	const BodyOBB& boxOne = blockOne.OBB();
+	const BodyOBB& boxTwo = blockTwo.OBB();
+
+	// World space axes and half sizes of each block, loaded once for all the tests
+	Vect axesOne[3];
+	Vect axesTwo[3];
+	loadOBBAxes(boxOne, axesOne);
+	loadOBBAxes(boxTwo, axesTwo);
+	const Vect halfSizeOne = boxOne.halfSize.getVect();
+	const Vect halfSizeTwo = boxTwo.halfSize.getVect();
+	const Vect centerOne = boxOne.center.getVect();
+	const Vect centerTwo = boxTwo.center.getVect();
+
+	// Most pairs are nowhere near each other - reject those on their world bounds first
+	// (worked out from the boxes, the same values as the store's bounds, so we don't touch another array)
+	const Vect extentOne = obbExtents(halfSizeOne, axesOne);
+	const Vect extentTwo = obbExtents(halfSizeTwo, axesTwo);
+	for (int k = 0; k < 3; k++)
+	{
+		if (centerOne[k] - extentOne[k] > centerTwo[k] + extentTwo[k] ||
+			centerTwo[k] - extentTwo[k] > centerOne[k] + extentOne[k])
+		{
+			return false;
+		}
+	}
 
 	// Calculate difference of centers
-	Matrix transOne = blockOne.transformMatrix;;
-	Matrix transTwo = blockTwo.transformMatrix;
-	Vect diffCenter = transTwo.v3 - transOne.v3;
+	Vect diffCenter = centerTwo - centerOne;
+
+	// Then on bounding spheres (catches rotated boxes whose bounds overlap at the corners)
+	const float radiusSum = boxOne.boundingRadius + boxTwo.boundingRadius;
+	if (diffCenter.magSqr() > radiusSum * radiusSum) return false;
+
+	const bool fastNormalize = collisionFastNormalize;
+
+	// Try last step's axis first if it's a face axis - blocks that were apart usually still are, along the same axis
+	if (cachedAxisInOut && *cachedAxisInOut < 6 &&
+		separatedOnFaceAxis(halfSizeOne, axesOne, halfSizeTwo, axesTwo, diffCenter, *cachedAxisInOut, fastNormalize))
+	{
+		return false;
+	}
+
+	// Reject on the relative rotation if that's our test, so the axis tests below only run for blocks that touch
+	if (collisionSatMode == SAT_RELATIVE_ROTATION)
+	{
+		const unsigned int separatingAxis = separatingAxisByRelativeRotation(halfSizeOne, axesOne, halfSizeTwo, axesTwo, diffCenter);
+		if (separatingAxis != SAT_NO_AXIS)
+		{
+			if (cachedAxisInOut) *cachedAxisInOut = separatingAxis;
+			return false;
+		}
+	}
 
 	// Initially assume there is no contact at all
 	float penetration = FLT_MAX;
-	unsigned bestIndex = 0xFFFFFF;
+	unsigned bestIndex = SAT_NO_AXIS;
 
 	// Now we check each axis, and return if it shows boxes are not colliding
 	// Also keep track of smallest penetration
-	Vect axis0(transOne.v0);
+	Vect axis0(axesOne[0]);
 	TEST_AXIS(axis0, 0);
-	Vect axis1(transOne.v1);
+	Vect axis1(axesOne[1]);
 	TEST_AXIS(axis1, 1);
-	Vect axis2(transOne.v2);
+	Vect axis2(axesOne[2]);
 	TEST_AXIS(axis2, 2);
 
-	Vect axis3(transTwo.v0);
+	Vect axis3(axesTwo[0]);
 	TEST_AXIS(axis3, 3);
-	Vect axis4(transTwo.v1);
+	Vect axis4(axesTwo[1]);
 	TEST_AXIS(axis4, 4);
-	Vect axis5(transTwo.v2);
+	Vect axis5(axesTwo[2]);
 	TEST_AXIS(axis5, 5);
 
 	unsigned bestSingleAxis = bestIndex;
 
-	Vect axis6 = transOne.v0.cross(transTwo.v0);
-	if (!axis6.isZero())
-	{
-		TEST_AXIS(axis6, 6);
-	}
-	Vect axis7 = transOne.v0.cross(transTwo.v1);
-	if (!axis7.isZero())
-	{
-		TEST_AXIS(axis7, 7);
-	}
-	Vect axis8 = transOne.v0.cross(transTwo.v2);
-	if (!axis8.isZero())
+	// Then the axes from each pair of edges, one edge from each block (the first block's axis / 3, the second's % 3)
+	if (fastNormalize)
 	{
-		TEST_AXIS(axis8, 8);
-	}
-	Vect axis9 = transOne.v1.cross(transTwo.v0);
-	if (!axis9.isZero())
-	{
-		TEST_AXIS(axis9, 9);
-	}
-	Vect axis10 = transOne.v1.cross(transTwo.v1);
-	if (!axis10.isZero())
-	{
-		TEST_AXIS(axis10, 10);
-	}
-	Vect axis11 = transOne.v1.cross(transTwo.v2);
-	if (!axis11.isZero())
-	{
-		TEST_AXIS(axis11, 11);
-	}
-	Vect axis12 = transOne.v2.cross(transTwo.v0);
-	if (!axis12.isZero())
-	{
-		TEST_AXIS(axis12, 12);
-	}
-	Vect axis13 = transOne.v2.cross(transTwo.v1);
-	if (!axis13.isZero())
-	{
-		TEST_AXIS(axis13, 13);
+		// Skip the nearly parallel pairs, like the precise path does, and normalize the rest 4 at a time
+		Vect edgeAxes[9];
+		bool edgeUsable[9];
+		for (unsigned k = 0; k < 9; k++)
+		{
+			edgeAxes[k] = axesOne[k / 3].cross(axesTwo[k % 3]);
+			edgeUsable[k] = !edgeAxes[k].isZero() && edgeAxes[k].magSqr() >= 0.0001f;
+		}
+		Vect::normFastArray(edgeAxes, 9);
+
+		for (unsigned k = 0; k < 9; k++)
+		{
+			if (edgeUsable[k])
+			{
+				TEST_UNIT_AXIS(edgeAxes[k], 6 + k);
+			}
+		}
 	}
-	Vect axis14 = transOne.v2.cross(transTwo.v2);
-	if (!axis14.isZero())
+	else
 	{
-		TEST_AXIS(axis14, 14);
+		for (unsigned k = 0; k < 9; k++)
+		{
+			Vect edgeAxis = axesOne[k / 3].cross(axesTwo[k % 3]);
+			if (!edgeAxis.isZero())
+			{
+				TEST_AXIS(edgeAxis, 6 + k);
+			}
+		}
 	}
 
 	// Make sure nothing went wrong
-	if (bestIndex == 0xffffff) return 0;
-	assert(bestIndex != 0xffffff);
+	if (bestIndex == SAT_NO_AXIS) return 0;
+	assert(bestIndex != SAT_NO_AXIS);
+
+	// Touching - next step starts from the axis we touch on
+	if (cachedAxisInOut) *cachedAxisInOut = bestIndex;
 
 	// If we get here we know there was a collision
 	// Depending on which axis, we need to deal with it
 	if (bestIndex < 3)
 	{
-		// Vertex of box two is colliding with face of box one. Fill our contact data
-		fillContactPointFaceCollision(blockOne, blockTwo, diffCenter, contact, bestIndex, penetration);
-
-		// This is a bit of a hack to improve performance
-		// Need to check if any axes are aligned. Might need to adjust contact point to center it on a face
-		// Previous function always returns a corner
-		Vect bestAxis = transOne.v[bestIndex];
-
-		// See if any of other block's axes align with this one
-		bool matchingAxis = false;
-		for (int k = 0; k < 3; k++)
-		{
-			if (bestAxis.isEqual(transTwo.v[k], 0.001f) ||
-				bestAxis.isEqual(transTwo.v[k] * -1.0f, 0.001f))
-			{
-				matchingAxis = true;
-			}
-		}
-
-		if (matchingAxis)
-		{
-			// See how many of block 1's corners are inside block 2
-			Vect pointSum(0.0f, 0.0f, 0.0f);
-			int numPointsInside = 0;
-
-			Vect corner;
-			corner = blockOne.GetCorner(MIN, MIN, MIN);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MIN, MIN, MAX);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MIN, MAX, MIN);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MIN, MAX, MAX);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MAX, MIN, MIN);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MAX, MIN, MAX);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MAX, MAX, MIN);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-			corner = blockOne.GetCorner(MAX, MAX, MAX);
-			if (blockTwo.PointInsideBlock(corner)) { pointSum += corner; numPointsInside++; }
-
-			// If 4 corners are penetrating, set the contact point to the center of the face
-			if (numPointsInside == 4)
-			{
-				contact.contactPoint = pointSum * (1.0f / float(numPointsInside));
-			}
-		}
+		// Box two is colliding with face of box one. Fill our contact data
+		fillContactPointFaceCollision(blockOne, blockTwo, diffCenter, manifold, bestIndex, penetration);
 	}
 	else if (bestIndex < 6)
 	{
-		// Vertex of box one is colliding with face of box two. Fill our contact data
-		fillContactPointFaceCollision(blockTwo, blockOne, diffCenter * -1.0f, contact, bestIndex - 3, penetration);
+		// Box one is colliding with face of box two. Fill our contact data
+		fillContactPointFaceCollision(blockTwo, blockOne, diffCenter * -1.0f, manifold, bestIndex - 3, penetration);
 	}
 	else
 	{
@@ -205,33 +450,31 @@ bool CheckColliding(Block& blockOne, Block& blockTwo, PhysicsContact& contact)
 		bestIndex -= 6;
 		unsigned oneAxisIndex = bestIndex / 3;
 		unsigned twoAxisIndex = bestIndex % 3;
-		Vect oneAxis = transOne.v[oneAxisIndex];
-		Vect twoAxis = transTwo.v[twoAxisIndex];
+		Vect oneAxis = axesOne[oneAxisIndex];
+		Vect twoAxis = axesTwo[twoAxisIndex];
 		Vect axis = oneAxis.cross(twoAxis);
-		axis.norm();
+		if (fastNormalize) axis.normFast();
+		else axis.norm();
 
 		// If not pointing from box one to box two, correct it
 		if (axis.dot(diffCenter) > 0.0f) axis = axis * -1.0f;
 
 		// We know the axis, but need to figure out which edges are colliding
 		// Find center points of the two edges
-		Vect ptOnEdgeBlockOne = blockOne.scale * 0.5f;
-		Vect ptOnEdgeBlockTwo = blockTwo.scale * 0.5f;
+		Vect ptOnEdgeBlockOne = halfSizeOne;
+		Vect ptOnEdgeBlockTwo = halfSizeTwo;
 		for (unsigned int i = 0; i < 3; i++)
 		{
 			if (i == oneAxisIndex) ptOnEdgeBlockOne[i] = 0.0f;
-			else if (transOne.v[i].dot(axis) > 0.0f) ptOnEdgeBlockOne[i] = -ptOnEdgeBlockOne[i];
+			else if (axesOne[i].dot(axis) > 0.0f) ptOnEdgeBlockOne[i] = -ptOnEdgeBlockOne[i];
 
 			if (i == twoAxisIndex) ptOnEdgeBlockTwo[i] = 0.0f;
-			else if (transTwo.v[i].dot(axis) < 0.0f) ptOnEdgeBlockTwo[i] = -ptOnEdgeBlockTwo[i];
+			else if (axesTwo[i].dot(axis) < 0.0f) ptOnEdgeBlockTwo[i] = -ptOnEdgeBlockTwo[i];
 		}
 
 		// Convert these midpoints into world coordinates
-		ptOnEdgeBlockOne = ptOnEdgeBlockOne * transOne;
-		ptOnEdgeBlockTwo = ptOnEdgeBlockTwo * transTwo;
-
-		Vect halfSizeOne = blockOne.scale * 0.5f;
-		Vect halfSizeTwo = blockTwo.scale * 0.5f;
+		ptOnEdgeBlockOne = blockOne.Transform().transformPoint(ptOnEdgeBlockOne);
+		ptOnEdgeBlockTwo = blockTwo.Transform().transformPoint(ptOnEdgeBlockTwo);
 
 		// calculate the contact point
 		Vect vertex = contactPointEdgeEdge(
@@ -240,20 +483,22 @@ bool CheckColliding(Block& blockOne, Block& blockTwo, PhysicsContact& contact)
 			bestSingleAxis > 2
 			);
 
-		contact.penetration = penetration;
-		contact.normal = axis;
-		contact.contactPoint = vertex;
-		contact.blocks[0] = &blockOne;
-		contact.blocks[1] = &blockTwo;
+		manifold.penetration = penetration;
+		manifold.normal = axis;
+		manifold.numPoints = 1;
+		manifold.points[0] = vertex;
+		manifold.penetrations[0] = penetration;
+		manifold.blocks[0] = &blockOne;
+		manifold.blocks[1] = &blockTwo;
 	}
 
-	if (contact.penetration > 0.0f)
+	if (manifold.penetration > 0.0f)
 	{
 		return 1;
 	}
 	else
 	{
-		contact.Reset();
+		manifold.Reset();
 		return 0;
 	}
 };
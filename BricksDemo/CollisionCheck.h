@@ -2,44 +2,95 @@
 #include <float.h>
 #include <assert.h>
 #include "Block.h"
+#include "SeparatingAxisCache.h"
 
-class PhysicsContact;
+struct ContactManifold;
 
-// Check if two blocks are colliding, fill contact data if so
-bool CheckColliding(Block& blockOne, Block& blockTwo, PhysicsContact& contact);
+// Check if two blocks are colliding, fill the contact manifold if so
+// Face contacts get up to 4 points (block two's face clipped against block one's), edge contacts get one
+// With cachedAxisInOut, that axis (last step's, or SAT_NO_AXIS) is tried before the full search if it's a face
+// axis, and it's set to the axis that separates the blocks or the one they touch on - the verdict and contact don't change
+bool CheckColliding(Block& blockOne, Block& blockTwo, ContactManifold& manifold, unsigned int* cachedAxisInOut = 0);
 
-// Fill contact data for a point face collision
+// Whether a face axis (0-5, numbered like CheckColliding's) still separates two blocks - the test CheckColliding
+// runs on it, so every pair this rejects CheckColliding rejects too. Edge axes (6-14) always give false
+bool SeparatedOnFaceAxis(Block& blockOne, Block& blockTwo, const unsigned int axisIn);
+
+// Fast normalize mode - the separating axes and edge contact normals use Vect::normFast instead of norm
+// Off unless built with COLLISION_FAST_NORMALIZE (CMake option BRICKS_FAST_NORMALIZE), and can be flipped at runtime
+// Trades a relative error under 5e-7 in each axis for the division and square root; results then depend on the CPU
+void SetCollisionFastNormalize(const bool fastIn);
+bool GetCollisionFastNormalize();
+
+// Which separating axis test CheckColliding rejects pairs with
+// The two round differently, so pairs that are just touching can get a different verdict (and the simulation a
+// different state hash); blocks both tests find touching get the same contact, from the projected axes
+enum SeparatingAxisMode
+{
+	SAT_PROJECTED_AXES,		// Build each of the 15 axes, normalize it and project both blocks onto it
+	SAT_RELATIVE_ROTATION	// Work out R = A^T B and |R| once and read all 15 axes off their entries, then
+							// run the projected axes test only for the blocks that touch, to find the contact
+};
+
+// Separating axis test mode (projected axes unless changed)
+void SetCollisionSatMode(const SeparatingAxisMode modeIn);
+SeparatingAxisMode GetCollisionSatMode();
+
+// Fill the manifold for a face collision - the face of block one on best against block two
 void fillContactPointFaceCollision(
 	Block& blockOne,
 	Block& blockTwo,
 	const Vect& toCenter,
-	PhysicsContact& pContact,
+	ContactManifold& manifold,
 	unsigned int best,
 	float penetration);
 
+// World space axes of a block's packed box, as Vects for the axis tests
+static inline void loadOBBAxes(const BodyOBB& boxIn, Vect axesOut[3])
+{
+	axesOut[0] = boxIn.axes[0].getVect();
+	axesOut[1] = boxIn.axes[1].getVect();
+	axesOut[2] = boxIn.axes[2].getVect();
+};
+
+// Half the size of a block's world space bounds along x, y and z
+// Same sums in the same order as BodyStore::CalculateDerivedData, so the bounds come out the same
+static inline Vect obbExtents(const Vect& halfSizeIn, const Vect axesIn[3])
+{
+	Vect extent;
+	for (int k = 0; k < 3; k++)
+	{
+		extent[k] =
+			halfSizeIn[0] * fabsf(axesIn[0][k]) +
+			halfSizeIn[1] * fabsf(axesIn[1][k]) +
+			halfSizeIn[2] * fabsf(axesIn[2][k]);
+	}
+	return extent;
+};
+
 // Transform an block to a length in a given axis
 // Used for separating axis tests
-static inline float transToAxis(Block& blockIn,
+static inline float transToAxis(const Vect& halfSizeIn,
+	const Vect axesIn[3],
 	const Vect& axisIn)
 {
-	Matrix transMat = blockIn.transformMatrix;
-
-	Vect halfSize = blockIn.scale * 0.5f;
 	return
-		halfSize[0] * abs(axisIn.dot(transMat.v0)) +
-		halfSize[1] * abs(axisIn.dot(transMat.v1)) +
-		halfSize[2] * abs(axisIn.dot(transMat.v2));
+		halfSizeIn[0] * abs(axisIn.dot(axesIn[0])) +
+		halfSizeIn[1] * abs(axisIn.dot(axesIn[1])) +
+		halfSizeIn[2] * abs(axisIn.dot(axesIn[2]));
 };
 
 // determine how much the objects penetrate along a given axis
-static inline float penOnAxis(Block& blockOne,
-	Block& blockTwo,
+static inline float penOnAxis(const Vect& halfSizeOne,
+	const Vect axesOne[3],
+	const Vect& halfSizeTwo,
+	const Vect axesTwo[3],
 	const Vect& axis,
 	const Vect& diffCenter)
 {
 	// Projections of each box
-	const float oneProjection = transToAxis(blockOne, axis);
-	const float twoProjection = transToAxis(blockTwo, axis);
+	const float oneProjection = transToAxis(halfSizeOne, axesOne, axis);
+	const float twoProjection = transToAxis(halfSizeTwo, axesTwo, axis);
 
 	// Distance between block centers on this axis
 	const float dist = abs(diffCenter.dot(axis));
@@ -48,12 +99,14 @@ static inline float penOnAxis(Block& blockOne,
 	return oneProjection + twoProjection - dist;
 };
 
-// Test whether blocks are penetrating along a given axis
+// Test whether blocks are penetrating along a given unit length axis
 // Returns bool and updates the smallest penetration if necessary
-static inline bool testAxis(
-	Block& blockOne,
-	Block& blockTwo,
-	Vect& axis,
+static inline bool testUnitAxis(
+	const Vect& halfSizeOne,
+	const Vect axesOne[3],
+	const Vect& halfSizeTwo,
+	const Vect axesTwo[3],
+	const Vect& axis,
 	const Vect& toCenter,
 	unsigned index,
 
@@ -61,13 +114,8 @@ static inline bool testAxis(
 	unsigned& smallestCase
 	)
 {
-	// No need to check if lines are parallel
-	if (axis.magSqr() < 0.0001f) return true;
-	// Normalize the axis
-	axis.norm();
-
 	// Calculate penetration on this axis
-	const float pen = penOnAxis(blockOne, blockTwo, axis, toCenter);
+	const float pen = penOnAxis(halfSizeOne, axesOne, halfSizeTwo, axesTwo, axis, toCenter);
 
 	// Update smallest penetration if necessary
 	if (pen < 0.0f) return false;
@@ -78,6 +126,93 @@ static inline bool testAxis(
 	return true;
 };
 
+// Test whether blocks are penetrating along a given axis, normalizing it first
+// Returns bool and updates the smallest penetration if necessary
+static inline bool testAxis(
+	const Vect& halfSizeOne,
+	const Vect axesOne[3],
+	const Vect& halfSizeTwo,
+	const Vect axesTwo[3],
+	Vect& axis,
+	const Vect& toCenter,
+	unsigned index,
+	const bool fastNormalize,
+
+	float& smallestPenetration, // updated by this function
+	unsigned& smallestCase
+	)
+{
+	// No need to check if lines are parallel
+	if (axis.magSqr() < 0.0001f) return true;
+	// Normalize the axis
+	if (fastNormalize) axis.normFast();
+	else axis.norm();
+
+	return testUnitAxis(halfSizeOne, axesOne, halfSizeTwo, axesTwo, axis, toCenter, index, smallestPenetration, smallestCase);
+};
+
+// Box box overlap test with the relative rotation (Gottschalk's OBB test)
+// Everything is in block one's frame: R[i][j] = axesOne[i] . axesTwo[j], and t is the center of two.
+// Each of the 15 axes is then a few multiplies of those entries - no axis is built or normalized,
+// since the overlap and distance along an unnormalized axis have the same sign as along the unit one.
+// Nearly parallel edge pairs are skipped, like the projected axes test does
+// Returns the first axis that separates them (numbered like CheckColliding's), or SAT_NO_AXIS
+static inline unsigned int separatingAxisByRelativeRotation(
+	const Vect& halfSizeOne,
+	const Vect axesOne[3],
+	const Vect& halfSizeTwo,
+	const Vect axesTwo[3],
+	const Vect& diffCenter)
+{
+	float R[3][3];
+	float absR[3][3];
+	float t[3];
+	for (int i = 0; i < 3; i++)
+	{
+		t[i] = diffCenter.dot(axesOne[i]);
+		for (int j = 0; j < 3; j++)
+		{
+			R[i][j] = axesOne[i].dot(axesTwo[j]);
+			absR[i][j] = fabsf(R[i][j]);
+		}
+	}
+
+	// Block one's face axes
+	for (int i = 0; i < 3; i++)
+	{
+		const float radiusTwo = halfSizeTwo[0] * absR[i][0] + halfSizeTwo[1] * absR[i][1] + halfSizeTwo[2] * absR[i][2];
+		if (fabsf(t[i]) > halfSizeOne[i] + radiusTwo) return i;
+	}
+
+	// Block two's face axes
+	for (int j = 0; j < 3; j++)
+	{
+		const float radiusOne = halfSizeOne[0] * absR[0][j] + halfSizeOne[1] * absR[1][j] + halfSizeOne[2] * absR[2][j];
+		if (fabsf(t[0] * R[0][j] + t[1] * R[1][j] + t[2] * R[2][j]) > radiusOne + halfSizeTwo[j]) return 3 + j;
+	}
+
+	// Edge pairs, axesOne[i] x axesTwo[j] (its length squared is 1 - R[i][j]^2)
+	for (int i = 0; i < 3; i++)
+	{
+		const int i1 = (i + 1) % 3;
+		const int i2 = (i + 2) % 3;
+
+		for (int j = 0; j < 3; j++)
+		{
+			if (1.0f - R[i][j] * R[i][j] < 0.0001f) continue;
+
+			const int j1 = (j + 1) % 3;
+			const int j2 = (j + 2) % 3;
+
+			const float radiusOne = halfSizeOne[i1] * absR[i2][j] + halfSizeOne[i2] * absR[i1][j];
+			const float radiusTwo = halfSizeTwo[j1] * absR[i][j2] + halfSizeTwo[j2] * absR[i][j1];
+			if (fabsf(t[i2] * R[i1][j] - t[i1] * R[i2][j]) > radiusOne + radiusTwo) return 6 + 3 * i + j;
+		}
+	}
+
+	return SAT_NO_AXIS;
+};
+
 // Calculate the contact point for an edge to edge collision
 static inline Vect contactPointEdgeEdge(
 	const Vect& ptOnEdgeBlockOne,
@@ -5,16 +5,13 @@
 #include "Matrix.h"
 #include "Camera.h"
 #include <time.h>
-#include "PhysicsContact.h"
-#include "CollisionCheck.h"
-#include <stdlib.h>
 
 // Callback needed to handle Window messages
 LRESULT CALLBACK wndProc(HWND hWnd, UINT message, WPARAM wParam, LPARAM lParam);
 
 // Constructor
 Demo::Demo()
-	:	cam(), motionBlur(), ground(), bricks(), bullet(), crosshairX(), crosshairY(),
+	:	cam(), motionBlur(), world(), brickRotations(), crosshairX(), crosshairY(),
 		window(0), swapChain(0), device(0), deviceCon(0),
 		backBuffer(0), backBufferView(0), depthTexture(0), depthView(0),
 		vShader(0), pShader(0), inputLayout(0), rastState(0),
@@ -79,7 +76,7 @@ void Demo::privFireBullet(const float elapsedTime)
 	bool lmbPressed = (lmb & 0x80) != 0;
 
 	// Fire if button is pressed and the wait time has elapsed
-	if (lmbPressed && (!bullet.active || currTime >= waitTime))
+	if (lmbPressed && (!world.bullet.Active() || currTime >= waitTime))
 	{
 		// Need to figure out our target
 		float width = cam.nearWidth + (cam.farWidth - cam.nearWidth) * (490.0f - cam.nearDist) / (cam.farDist - cam.nearDist);
@@ -95,113 +92,11 @@ void Demo::privFireBullet(const float elapsedTime)
 
 		currTime = 0.0f;
 
-		// Set our velocity to be toward the target point
-		this->bullet.position = this->cam.vPos;
-		this->bullet.velocity = target - this->bullet.position;
-		this->bullet.velocity.norm();
-		this->bullet.velocity *= 1000.0f;
-		this->bullet.rotation = Quat(0.0f, 0.0f, 0.0f, 1.0f);
-		this->bullet.angVelocity = Vect(0.0f, 0.0f, 0.0f);
-		this->bullet.active = 1;
-		this->bullet.gravityNow = false;
+		// Fire from the camera toward the target point
+		this->world.FireBullet(this->cam.vPos, target);
 	}
 }
 
-// Check our collisions and handle them accordingly
-void Demo::privCheckCollisions(const float timeIn)
-{
-	PhysicsContact contact;
-	contact.Reset();
-
-	// Check bullet and ground
-	if (CheckColliding(ground, bullet, contact))
-	{
-		// Handle collision
-		contact.CalculateData(timeIn);
-		contact.ChangeVelocity();
-		contact.ChangePosition();
-		contact.Reset();
-	}
-
-	// Check all bricks against ground
-	for (int i = 0; i < NUM_BRICKS; i++)
-	{ 
-		if (CheckColliding(bricks[i], ground, contact))
-		{
-			// Handle collision
-			contact.CalculateData(timeIn);
-			contact.ChangeVelocity();
-			contact.ChangePosition();
-			contact.Reset();
-		}
-	}
-
-	// Check all bricks against bullet
-	for (int i = 0; i < NUM_BRICKS; i++)
-	{ 
-		if (CheckColliding(bullet, bricks[i], contact))
-		{
-			contact.CalculateData(timeIn);
-
-			// Time to have some fun with all blocks within certain distance of this collision
-			// Launch those bricks upward with random angular velocity
-			for (int k = 0; k < NUM_BRICKS; k++)
-			{
-				// use mag squared to avoid square root
-				Vect diffPos = bricks[k].position - contact.contactPoint;
-				float magSquared = diffPos.magSqr();
-				
-				if (magSquared < 1500.0f && bricks[k].position[1] >= bricks[i].position[1])
-				{
-					Vect velocityChange(diffPos[0] > 0 ? 30.0f : -30.0f, 200.0f, 0.0f);
-					bricks[k].velocity += velocityChange;
-
-					static int x = 987444303;
-					srand(x);
-					x += 5134;
-
-					// Random angular velocity
-					Vect angVelocityChange(0.0f, 0.0f, 0.0f);
-					angVelocityChange[0] = (float)(rand() % 60 - 30);
-					angVelocityChange[1] = (float)(rand() % 60 - 30);
-					angVelocityChange[2] = (float)(rand() % 60 - 30);
-
-					bricks[k].angVelocity += angVelocityChange;
-				}
-			}
-
-			// Slow time on this collision
-			if (!this->timeSlowed)
-			{
-				this->slowTimer = 0.0f;
-				this->timeSlowed = true;
-				this->motionBlur.blurOn = true;
-			}
-			contact.Reset();
-			bullet.active = false;
-			break;
-		}
-	}
-
-	// Now check all bricks with each other
-	for (int i = 0; i < NUM_BRICKS; i++)
-	{
-		for (int j = i + 1; j < NUM_BRICKS; j++)
-		{
-			if (CheckColliding(bricks[i], bricks[j], contact))
-			{
-				// Handle collision accordingly
-				contact.CalculateData(timeIn);
-				contact.ChangeVelocity();
-				contact.ChangePosition();
-				contact.Reset();
-			}
-		}
-	}
-
-	return;
-};
-
 // Check if time is slowed, and whether it should return to normal
 void Demo::privCheckSlowTime(const float elapsedTime)
 {
@@ -218,13 +113,8 @@ void Demo::privCheckSlowTime(const float elapsedTime)
 
 void Demo::privReset()
 {
-	// Setup ground
-	ground.color = Vect(0.0f, 0.4f, 0.0f, 1.0f);
-	ground.position = Vect(0.0f, -2.5f, 0.0f);
-	ground.scale = Vect(1000.0f, 5.0f, 3000.0f);
-	ground.inverseMass = 0.0f;
-	ground.CalcInertiaTensor();
-	ground.CalculateDerivedData();
+	// Setup ground, bricks, and bullet
+	world.Reset(NUM_BRICKS);
 
 	// Setup crosshairs
 	crosshairX.position = Vect(0.0f, 0.0f, 0.0000005f);
@@ -232,41 +122,6 @@ void Demo::privReset()
 	crosshairY.position = Vect(0.0f, 0.0f, 0.0000005f);
 	crosshairY.scale = Vect(0.01f, 0.20f, 0.00000001f);
 
-	// Set the 4 colors for our bricks
-	Vect colors[4];
-	colors[0] = Vect(1.0f, 0.0f, 0.0f, 1.0f);
-	colors[1] = Vect(0.0f, 1.0f, 0.0f, 1.0f);
-	colors[2] = Vect(0.0f, 0.0f, 1.0f, 1.0f);
-	colors[3] = Vect(1.0f, 1.0f, 0.0f, 1.0f);
-
-	// Setup the bricks
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 6; j++)
-		{ 
-			int index = i * 6 + j;
-			bricks[index].scale = Vect(20.0f, 20.0f, 20.f);
-			bricks[index].color = colors[((j % 4) + i) % 4];
-			bricks[index].position = Vect(-50.0f + 20.0f * j, 10.0f + 20.0f * i, -500.0f);
-			bricks[index].velocity = Vect(0.0f, 0.0f, 0.0f);
-			bricks[index].angVelocity = Vect(0.0f, 0.0f, 0.0f);
-			bricks[index].rotation = Quat(0.0f, 0.0f, 0.0f, 1.0f);
-			bricks[index].inverseMass = 0.2f;
-			bricks[index].gravityNow = false;
-			bricks[index].CalcInertiaTensor();
-		}
-	}
-
-	// Setup our bullet
-	bullet.scale = Vect(2.0f, 2.0f, 2.f);
-	bullet.color = Vect(0.0f, 0.0f, 0.0f, 1.0f);
-	bullet.position = Vect(0.0f, 1000.0f, 0.0f);
-	bullet.inverseMass = 0.5f;
-	bullet.gravityNow = false;
-	bullet.gravityEver = false;
-	bullet.active = false;
-	bullet.CalcInertiaTensor();
-
 	// Turn off slow time and motion blur
 	this->timeSlowed = false;
 	this->motionBlur.blurOn = false;
@@ -425,18 +280,17 @@ void Demo::Update()
 	// Fire bullet
 	pDemo->privFireBullet(elapsedTime);
 
-	// update our bullet
-	pDemo->bullet.Update(elapsedTime);
+	// Step our physics objects and handle collisions
+	pDemo->world.Update(elapsedTime);
 
-	// update our bricks
-	for (int i = 0; i < NUM_BRICKS; i++)
+	// Slow time when the bullet hits a brick
+	if (pDemo->world.BulletHitBrick() && !pDemo->timeSlowed)
 	{
-		pDemo->bricks[i].Update(elapsedTime);
+		pDemo->slowTimer = 0.0f;
+		pDemo->timeSlowed = true;
+		pDemo->motionBlur.blurOn = true;
 	}
 
-	// Check for any collisions and handle them
-	pDemo->privCheckCollisions(elapsedTime);
-
 	// Check if space bar is pressed 
 	// If so reset the demo
 	short space = GetKeyState(0x20);
@@ -497,16 +351,17 @@ void Demo::Draw()
 	pDemo->deviceCon->UpdateSubresource(pDemo->projectionBuffer, 0, nullptr, &proj, 0, 0);
 
 	// Draw the ground
-	pDemo->ground.Draw();
+	pDemo->world.ground.Draw();
 
-	// Draw our bricks
-	for (int i = 0; i < NUM_BRICKS; i++)
+	// Draw our bricks, with their rotation matrices worked out in one batch
+	pDemo->world.CalcBrickRotations(pDemo->brickRotations);
+	for (int i = 0; i < pDemo->world.bricks.Count(); i++)
 	{
-		pDemo->bricks[i].Draw();
+		pDemo->world.bricks[i].Draw(pDemo->brickRotations[i]);
 	}
 
 	// Draw the bullet
-	pDemo->bullet.Draw();
+	pDemo->world.bullet.Draw();
 
 	// Now we're making sure our crosshairs are always fully lit.
 	// This allows us to get away without writing another shader
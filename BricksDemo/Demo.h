@@ -8,8 +8,10 @@
 #include "Camera.h"
 #include "Crosshair.h"
 #include "Block.h"
+#include "World.h"
 #include "MotionBlur.h"
 
+// Number of bricks in the demo's wall
 #define NUM_BRICKS 30
 
 // This class represents the whole brick demo. It initializes Direct3D, then handles all gameplay and rendering
@@ -48,7 +50,6 @@ private:
 	// Helper functions
 	void privMoveCrosshairs(const float elapsedTime);
 	void privFireBullet(const float elapsedTime);
-	void privCheckCollisions(const float elapsedTime);
 	void privCheckSlowTime(const float elapsedTime);
 	void privReset();
 
@@ -77,9 +78,10 @@ private:
 	MotionBlur					motionBlur;
 
 	// Our physics objects
-	Block						ground;
-	Block						bricks[NUM_BRICKS];
-	Block						bullet;
+	World						world;
+
+	// Scratch rotation matrices for drawing the bricks
+	std::vector<Matrix>			brickRotations;
 
 	// Crosshairs
 	Crosshair					crosshairX;
@@ -0,0 +1,520 @@
+#include "DynamicAABBTree.h"
+#include <math.h>
+#include <assert.h>
+#include <algorithm>
+
+// Constructor
+DynamicAABBTree::DynamicAABBTree(const float marginIn)
+	:	nodes(), proxies(), bounds(), pairs(), stack(), queryResults(),
+		margin(marginIn), root(-1), freeList(-1), numBlocks(-1)
+{
+};
+
+// Destructor
+DynamicAABBTree::~DynamicAABBTree()
+{
+};
+
+// Throw away all proxies (call when the blocks are replaced)
+void DynamicAABBTree::Reset()
+{
+	nodes.clear();
+	proxies.clear();
+	root = -1;
+	freeList = -1;
+	numBlocks = -1;
+};
+
+// Grab a node off the free list, or add a new one
+int DynamicAABBTree::privAllocateNode()
+{
+	int node;
+	if (freeList != -1)
+	{
+		node = freeList;
+		freeList = nodes[node].parent;
+	}
+	else
+	{
+		node = (int)nodes.size();
+		nodes.push_back(Node());
+	}
+
+	nodes[node].parent = -1;
+	nodes[node].child1 = -1;
+	nodes[node].child2 = -1;
+	nodes[node].height = 0;
+	nodes[node].block = -1;
+	return node;
+};
+
+// Put a node back on the free list
+void DynamicAABBTree::privFreeNode(const int nodeIn)
+{
+	nodes[nodeIn].parent = freeList;
+	nodes[nodeIn].height = -1;
+	freeList = nodeIn;
+};
+
+// Add a leaf, next to whichever sibling grows the tree's surface area the least
+void DynamicAABBTree::privInsertLeaf(const int leafIn)
+{
+	if (root == -1)
+	{
+		root = leafIn;
+		nodes[root].parent = -1;
+		return;
+	}
+
+	// Walk down to the best sibling
+	const AABB leafBox = nodes[leafIn].box;
+	int index = root;
+	while (nodes[index].block == -1)
+	{
+		const int child1 = nodes[index].child1;
+		const int child2 = nodes[index].child2;
+
+		const float area = AABBSurfaceArea(nodes[index].box);
+		AABB combined;
+		AABBCombine(nodes[index].box, leafBox, combined);
+		const float combinedArea = AABBSurfaceArea(combined);
+
+		// Cost of making a new parent for this node and the leaf
+		const float cost = 2.0f * combinedArea;
+
+		// Minimum cost of pushing the leaf further down
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		AABB box;
+		AABBCombine(leafBox, nodes[child1].box, box);
+		float cost1 = AABBSurfaceArea(box) + inheritanceCost;
+		if (nodes[child1].block == -1) cost1 -= AABBSurfaceArea(nodes[child1].box);
+
+		AABBCombine(leafBox, nodes[child2].box, box);
+		float cost2 = AABBSurfaceArea(box) + inheritanceCost;
+		if (nodes[child2].block == -1) cost2 -= AABBSurfaceArea(nodes[child2].box);
+
+		if (cost < cost1 && cost < cost2) break;
+
+		index = (cost1 < cost2) ? child1 : child2;
+	}
+
+	// Make a new parent for the sibling and the leaf
+	const int sibling = index;
+	const int oldParent = nodes[sibling].parent;
+	const int newParent = privAllocateNode();
+	nodes[newParent].parent = oldParent;
+	AABBCombine(leafBox, nodes[sibling].box, nodes[newParent].box);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leafIn;
+	nodes[sibling].parent = newParent;
+	nodes[leafIn].parent = newParent;
+
+	if (oldParent != -1)
+	{
+		if (nodes[oldParent].child1 == sibling) nodes[oldParent].child1 = newParent;
+		else nodes[oldParent].child2 = newParent;
+	}
+	else
+	{
+		root = newParent;
+	}
+
+	// Walk back up fixing heights and boxes
+	index = nodes[leafIn].parent;
+	while (index != -1)
+	{
+		index = privBalance(index);
+
+		const int child1 = nodes[index].child1;
+		const int child2 = nodes[index].child2;
+		nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+		AABBCombine(nodes[child1].box, nodes[child2].box, nodes[index].box);
+
+		index = nodes[index].parent;
+	}
+};
+
+// Take a leaf out of the tree (the leaf node itself isn't freed)
+void DynamicAABBTree::privRemoveLeaf(const int leafIn)
+{
+	if (leafIn == root)
+	{
+		root = -1;
+		return;
+	}
+
+	const int parent = nodes[leafIn].parent;
+	const int grandParent = nodes[parent].parent;
+	const int sibling = (nodes[parent].child1 == leafIn) ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != -1)
+	{
+		// Sibling takes the parent's place
+		if (nodes[grandParent].child1 == parent) nodes[grandParent].child1 = sibling;
+		else nodes[grandParent].child2 = sibling;
+		nodes[sibling].parent = grandParent;
+		privFreeNode(parent);
+
+		// Walk back up fixing heights and boxes
+		int index = grandParent;
+		while (index != -1)
+		{
+			index = privBalance(index);
+
+			const int child1 = nodes[index].child1;
+			const int child2 = nodes[index].child2;
+			nodes[index].height = 1 + std::max(nodes[child1].height, nodes[child2].height);
+			AABBCombine(nodes[child1].box, nodes[child2].box, nodes[index].box);
+
+			index = nodes[index].parent;
+		}
+	}
+	else
+	{
+		root = sibling;
+		nodes[sibling].parent = -1;
+		privFreeNode(parent);
+	}
+};
+
+// Rotate a node's taller grandchild up if its children's heights differ by more than one
+// Returns the node now sitting where nodeIn was
+int DynamicAABBTree::privBalance(const int nodeIn)
+{
+	const int iA = nodeIn;
+	Node& A = nodes[iA];
+	if (A.block != -1 || A.height < 2) return iA;
+
+	const int iB = A.child1;
+	const int iC = A.child2;
+	Node& B = nodes[iB];
+	Node& C = nodes[iC];
+
+	const int balance = C.height - B.height;
+
+	// Rotate C up
+	if (balance > 1)
+	{
+		const int iF = C.child1;
+		const int iG = C.child2;
+		Node& F = nodes[iF];
+		Node& G = nodes[iG];
+
+		// Swap A and C
+		C.child1 = iA;
+		C.parent = A.parent;
+		A.parent = iC;
+
+		if (C.parent != -1)
+		{
+			if (nodes[C.parent].child1 == iA) nodes[C.parent].child1 = iC;
+			else nodes[C.parent].child2 = iC;
+		}
+		else
+		{
+			root = iC;
+		}
+
+		// Keep the taller of F and G under C
+		if (F.height > G.height)
+		{
+			C.child2 = iF;
+			A.child2 = iG;
+			G.parent = iA;
+			AABBCombine(B.box, G.box, A.box);
+			AABBCombine(A.box, F.box, C.box);
+			A.height = 1 + std::max(B.height, G.height);
+			C.height = 1 + std::max(A.height, F.height);
+		}
+		else
+		{
+			C.child2 = iG;
+			A.child2 = iF;
+			F.parent = iA;
+			AABBCombine(B.box, F.box, A.box);
+			AABBCombine(A.box, G.box, C.box);
+			A.height = 1 + std::max(B.height, F.height);
+			C.height = 1 + std::max(A.height, G.height);
+		}
+
+		return iC;
+	}
+
+	// Rotate B up
+	if (balance < -1)
+	{
+		const int iD = B.child1;
+		const int iE = B.child2;
+		Node& D = nodes[iD];
+		Node& E = nodes[iE];
+
+		// Swap A and B
+		B.child1 = iA;
+		B.parent = A.parent;
+		A.parent = iB;
+
+		if (B.parent != -1)
+		{
+			if (nodes[B.parent].child1 == iA) nodes[B.parent].child1 = iB;
+			else nodes[B.parent].child2 = iB;
+		}
+		else
+		{
+			root = iB;
+		}
+
+		// Keep the taller of D and E under B
+		if (D.height > E.height)
+		{
+			B.child2 = iD;
+			A.child1 = iE;
+			E.parent = iA;
+			AABBCombine(C.box, E.box, A.box);
+			AABBCombine(A.box, D.box, B.box);
+			A.height = 1 + std::max(C.height, E.height);
+			B.height = 1 + std::max(A.height, D.height);
+		}
+		else
+		{
+			B.child2 = iE;
+			A.child1 = iD;
+			D.parent = iA;
+			AABBCombine(C.box, D.box, A.box);
+			AABBCombine(A.box, E.box, B.box);
+			A.height = 1 + std::max(C.height, D.height);
+			B.height = 1 + std::max(A.height, E.height);
+		}
+
+		return iB;
+	}
+
+	return iA;
+};
+
+// Add a leaf for a block, with its box grown by our margin
+int DynamicAABBTree::CreateProxy(const AABB& boundsIn, const int blockIn)
+{
+	const int proxy = privAllocateNode();
+
+	const Vect grow(margin, margin, margin);
+	nodes[proxy].box.min = boundsIn.min.getVect() - grow;
+	nodes[proxy].box.max = boundsIn.max.getVect() + grow;
+	nodes[proxy].block = blockIn;
+
+	privInsertLeaf(proxy);
+	return proxy;
+};
+
+// Remove a block's leaf
+void DynamicAABBTree::DestroyProxy(const int proxyIn)
+{
+	assert(nodes[proxyIn].block != -1);
+
+	privRemoveLeaf(proxyIn);
+	privFreeNode(proxyIn);
+};
+
+// Update a block's bounds. Only touches the tree if it left its fat box (returns true if so)
+bool DynamicAABBTree::MoveProxy(const int proxyIn, const AABB& boundsIn)
+{
+	assert(nodes[proxyIn].block != -1);
+
+	if (AABBContains(nodes[proxyIn].box, boundsIn)) return false;
+
+	privRemoveLeaf(proxyIn);
+
+	const Vect grow(margin, margin, margin);
+	nodes[proxyIn].box.min = boundsIn.min.getVect() - grow;
+	nodes[proxyIn].box.max = boundsIn.max.getVect() + grow;
+
+	privInsertLeaf(proxyIn);
+	return true;
+};
+
+// Fat box of a proxy
+const AABB& DynamicAABBTree::GetFatAABB(const int proxyIn) const
+{
+	return nodes[proxyIn].box;
+};
+
+// Height of the tree (0 for a single leaf, -1 if empty)
+int DynamicAABBTree::GetHeight() const
+{
+	return root == -1 ? -1 : nodes[root].height;
+};
+
+// Refit the tree to the blocks and find all pairs of active blocks whose bounds overlap
+void DynamicAABBTree::Update(const BlockPool& blocksIn)
+{
+	const BodyStore& store = blocksIn.Store();
+	pairs.clear();
+
+	// Start over if the blocks were replaced
+	if (numBlocks != blocksIn.Count())
+	{
+		this->Reset();
+		numBlocks = blocksIn.Count();
+		bounds.resize(numBlocks);
+		proxies.resize(numBlocks);
+		for (int i = 0; i < numBlocks; i++)
+		{
+			CalcBodyAABB(store, i, bounds[i]);
+			proxies[i] = CreateProxy(bounds[i], i);
+		}
+	}
+	else
+	{
+		for (int i = 0; i < numBlocks; i++)
+		{
+			CalcBodyAABB(store, i, bounds[i]);
+			MoveProxy(proxies[i], bounds[i]);
+		}
+	}
+
+	// Each block asks the tree what's near it, and keeps the pairs where it's the lower index
+	for (int i = 0; i < numBlocks; i++)
+	{
+		if (!store.flags[i].active) continue;
+
+		Query(bounds[i], queryResults);
+		for (size_t r = 0; r < queryResults.size(); r++)
+		{
+			const int j = queryResults[r];
+			if (j <= i || !store.flags[j].active) continue;
+			if (!AABBOverlap(bounds[i], bounds[j])) continue;
+
+			BlockPair pair;
+			pair.one = i;
+			pair.two = j;
+			pairs.push_back(pair);
+		}
+	}
+
+	std::sort(pairs.begin(), pairs.end(), BlockPairLess);
+};
+
+// Pairs found by the last update, in brute force loop order
+const std::vector<BlockPair>& DynamicAABBTree::GetPairs() const
+{
+	return pairs;
+};
+
+// Blocks whose fat boxes overlap the given box
+void DynamicAABBTree::Query(const AABB& boundsIn, std::vector<int>& blocksOut) const
+{
+	blocksOut.clear();
+	if (root == -1) return;
+
+	stack.clear();
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const int index = stack.back();
+		stack.pop_back();
+
+		const Node& node = nodes[index];
+		if (!AABBOverlap(node.box, boundsIn)) continue;
+
+		if (node.block != -1)
+		{
+			blocksOut.push_back(node.block);
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+};
+
+// Blocks whose fat boxes come within a radius of a point
+void DynamicAABBTree::QueryRadius(const Vect& centerIn, const float radiusIn, std::vector<int>& blocksOut) const
+{
+	blocksOut.clear();
+	if (root == -1) return;
+
+	const float radiusSqr = radiusIn * radiusIn;
+
+	stack.clear();
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const int index = stack.back();
+		stack.pop_back();
+
+		// Squared distance from the center to the closest point of the box
+		const Node& node = nodes[index];
+		float distSqr = 0.0f;
+		for (int k = 0; k < 3; k++)
+		{
+			const float c = centerIn[k];
+			if (c < node.box.min[k]) distSqr += (node.box.min[k] - c) * (node.box.min[k] - c);
+			else if (c > node.box.max[k]) distSqr += (c - node.box.max[k]) * (c - node.box.max[k]);
+		}
+		if (distSqr > radiusSqr) continue;
+
+		if (node.block != -1)
+		{
+			blocksOut.push_back(node.block);
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+};
+
+// Blocks whose fat boxes are hit by the ray origin + t * dir, for t in [0, maxT]
+void DynamicAABBTree::RayCast(const Vect& originIn, const Vect& dirIn, const float maxTIn, std::vector<int>& blocksOut) const
+{
+	blocksOut.clear();
+	if (root == -1) return;
+
+	stack.clear();
+	stack.push_back(root);
+	while (!stack.empty())
+	{
+		const int index = stack.back();
+		stack.pop_back();
+
+		// Slab test - clip the ray's range against each pair of box faces
+		const Node& node = nodes[index];
+		float tMin = 0.0f;
+		float tMax = maxTIn;
+		bool hit = true;
+		for (int k = 0; k < 3 && hit; k++)
+		{
+			const float o = originIn[k];
+			const float d = dirIn[k];
+			if (fabsf(d) < 1e-8f)
+			{
+				// Parallel to these faces, so we must already be between them
+				hit = (o >= node.box.min[k] && o <= node.box.max[k]);
+			}
+			else
+			{
+				const float invD = 1.0f / d;
+				float t1 = (node.box.min[k] - o) * invD;
+				float t2 = (node.box.max[k] - o) * invD;
+				if (t1 > t2) std::swap(t1, t2);
+				tMin = std::max(tMin, t1);
+				tMax = std::min(tMax, t2);
+				hit = (tMin <= tMax);
+			}
+		}
+		if (!hit) continue;
+
+		if (node.block != -1)
+		{
+			blocksOut.push_back(node.block);
+		}
+		else
+		{
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+};
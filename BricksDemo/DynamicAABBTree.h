@@ -0,0 +1,75 @@
+#ifndef DYNAMIC_AABB_TREE_H
+#define DYNAMIC_AABB_TREE_H
+
+#include <vector>
+#include "Broadphase.h"
+#include "BlockPool.h"
+
+// Bounding volume tree over the blocks, updated incrementally
+// Each leaf holds a "fat" box - the block's bounds grown by a margin. A block only gets
+// reinserted once it moves out of its fat box, so slow or resting bricks cost almost nothing.
+// Handles mixed sizes (ground, bricks, bullet) well, and doubles as a structure for
+// ray and radius queries.
+class DynamicAABBTree
+{
+public:
+	DynamicAABBTree(const float marginIn = 2.0f);
+	~DynamicAABBTree();
+
+	// Throw away all proxies (call when the blocks are replaced)
+	void Reset();
+
+	// Refit the tree to the blocks and find all pairs of active blocks whose bounds overlap
+	void Update(const BlockPool& blocksIn);
+
+	// Pairs found by the last update, in brute force loop order
+	const std::vector<BlockPair>& GetPairs() const;
+
+	// Blocks whose fat boxes overlap the given box
+	void Query(const AABB& boundsIn, std::vector<int>& blocksOut) const;
+
+	// Blocks whose fat boxes come within a radius of a point
+	void QueryRadius(const Vect& centerIn, const float radiusIn, std::vector<int>& blocksOut) const;
+
+	// Blocks whose fat boxes are hit by the ray origin + t * dir, for t in [0, maxT]
+	void RayCast(const Vect& originIn, const Vect& dirIn, const float maxTIn, std::vector<int>& blocksOut) const;
+
+	// Low level proxy interface - a proxy is a leaf holding a block index
+	int CreateProxy(const AABB& boundsIn, const int blockIn);
+	void DestroyProxy(const int proxyIn);
+	bool MoveProxy(const int proxyIn, const AABB& boundsIn);
+	const AABB& GetFatAABB(const int proxyIn) const;
+
+	// Height of the tree (0 for a single leaf, -1 if empty)
+	int GetHeight() const;
+
+private:
+	struct Node
+	{
+		AABB	box;
+		int		parent;		// next free node while on the free list
+		int		child1;
+		int		child2;
+		int		height;		// -1 while on the free list
+		int		block;		// -1 for internal nodes
+	};
+
+	int privAllocateNode();
+	void privFreeNode(const int nodeIn);
+	void privInsertLeaf(const int leafIn);
+	void privRemoveLeaf(const int leafIn);
+	int privBalance(const int nodeIn);
+
+	std::vector<Node>			nodes;
+	std::vector<int>			proxies;
+	std::vector<AABB>			bounds;
+	std::vector<BlockPair>		pairs;
+	mutable std::vector<int>	stack;
+	std::vector<int>			queryResults;
+	float						margin;
+	int							root;
+	int							freeList;
+	int							numBlocks;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "World.h"
+#include "CollisionCheck.h"
+
+// Print how to run us
+static void printUsage(const char* nameIn)
+{
+	fprintf(stderr,
+		"Usage: %s [options]\n"
+		"  --bricks N          number of bricks in the wall (default 30)\n"
+		"  --steps N           number of steps to simulate (default 10000)\n"
+		"  --dt F              time step in seconds (default 1/60)\n"
+		"  --broadphase NAME   brute, sap, grid or tree (default sap)\n"
+		"  --normalize NAME    precise or fast collision axis normalization (default %s)\n"
+		"  --sat NAME          axes or rotation separating axis test (default axes)\n"
+		"  --axis-cache NAME   on or off - start each pair from last step's separating axis (default off)\n",
+		nameIn, GetCollisionFastNormalize() ? "fast" : "precise");
+};
+
+// Headless driver - steps the brick world as fast as possible with no window or GPU
+int main(int argc, char* argv[])
+{
+	int numBricks = 30;
+	int numSteps = 10000;
+	float timeStep = 1.0f / 60.0f;
+	BroadphaseMode broadphase = BROADPHASE_SWEEP_AND_PRUNE;
+	bool axisCache = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const bool hasValue = (i + 1 < argc);
+
+		if (strcmp(argv[i], "--bricks") == 0 && hasValue) numBricks = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--steps") == 0 && hasValue) numSteps = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--dt") == 0 && hasValue) timeStep = (float)atof(argv[++i]);
+		else if (strcmp(argv[i], "--broadphase") == 0 && hasValue)
+		{
+			const char* name = argv[++i];
+			if (strcmp(name, "brute") == 0) broadphase = BROADPHASE_BRUTE_FORCE;
+			else if (strcmp(name, "sap") == 0) broadphase = BROADPHASE_SWEEP_AND_PRUNE;
+			else if (strcmp(name, "grid") == 0) broadphase = BROADPHASE_HASH_GRID;
+			else if (strcmp(name, "tree") == 0) broadphase = BROADPHASE_AABB_TREE;
+			else
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--normalize") == 0 && hasValue)
+		{
+			const char* name = argv[++i];
+			if (strcmp(name, "precise") == 0) SetCollisionFastNormalize(false);
+			else if (strcmp(name, "fast") == 0) SetCollisionFastNormalize(true);
+			else
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--sat") == 0 && hasValue)
+		{
+			const char* name = argv[++i];
+			if (strcmp(name, "axes") == 0) SetCollisionSatMode(SAT_PROJECTED_AXES);
+			else if (strcmp(name, "rotation") == 0) SetCollisionSatMode(SAT_RELATIVE_ROTATION);
+			else
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+		}
+		else if (strcmp(argv[i], "--axis-cache") == 0 && hasValue)
+		{
+			const char* name = argv[++i];
+			if (strcmp(name, "on") == 0) axisCache = true;
+			else if (strcmp(name, "off") == 0) axisCache = false;
+			else
+			{
+				printUsage(argv[0]);
+				return 1;
+			}
+		}
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (numBricks <= 0 || numSteps <= 0 || timeStep <= 0.0f)
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	World world;
+	world.SetBroadphase(broadphase);
+	world.SetAxisCache(axisCache);
+	world.Reset(numBricks);
+
+	// Fire the bullet at the wall from where the demo camera sits, so bricks get knocked down
+	const int fireStep = 30;
+
+	// How many bricks are still moving (faster than a few units a second) each step, to see how quickly the pile settles
+	const float movingSpeedSqr = 25.0f;
+	double movingBricks = 0.0;
+
+	std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (int i = 0; i < numSteps; i++)
+	{
+		if (i == fireStep)
+		{
+			world.FireBullet(Vect(0.0f, 50.0f, -10.0f), Vect(0.0f, 50.0f, -490.0f));
+		}
+
+		world.Update(timeStep);
+
+		for (int b = 0; b < numBricks; b++)
+		{
+			if (world.bricks[b].Velocity().magSqr() > movingSpeedSqr) movingBricks += 1.0;
+		}
+	}
+
+	std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	double seconds = std::chrono::duration<double>(end - start).count();
+
+	// Average brick height is a cheap way to check the wall actually came down
+	// The state hash (FNV-1a over brick positions and rotations) shows whether two builds
+	// produced bit for bit the same simulation
+	float heightSum = 0.0f;
+	unsigned int stateHash = 2166136261u;
+	for (int i = 0; i < numBricks; i++)
+	{
+		heightSum += world.bricks[i].Position()[1];
+
+		float state[7];
+		for (int k = 0; k < 3; k++) state[k] = world.bricks[i].Position()[k];
+		for (int k = 0; k < 4; k++) state[3 + k] = world.bricks[i].Rotation()[k];
+
+		const unsigned char* bytes = (const unsigned char*)state;
+		for (size_t b = 0; b < sizeof(state); b++)
+		{
+			stateHash = (stateHash ^ bytes[b]) * 16777619u;
+		}
+	}
+
+	printf("steps: %d  bricks: %d  time: %.3f s  steps/sec: %.1f  moving bricks/step: %.1f  avg brick height: %.3f  state hash: %08x\n",
+		numSteps, numBricks, seconds, double(numSteps) / seconds, movingBricks / double(numSteps), heightSum / float(numBricks), stateHash);
+
+	return 0;
+};
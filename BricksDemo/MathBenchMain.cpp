@@ -0,0 +1,617 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "Matrix.h"
+#include "Quat.h"
+#include "RigidTransform.h"
+#include "SymMatrix.h"
+#include "QuatBatch.h"
+#include "Vect3.h"
+
+// Number of matrices each kernel sweeps per pass (small enough to stay in L1)
+#define BENCH_SET_SIZE 256
+
+// Result sink so the optimizer can't throw the kernels away
+static volatile float benchSink = 0.0f;
+
+// One timed kernel, kept for the JSON report
+struct BenchResult
+{
+	std::string name;
+	const char* mode;
+	double nsPerOp;
+};
+
+static std::vector<BenchResult> benchResults;
+
+// "throughput" for independent ops over the set, "latency" for dependency chains
+static const char* benchMode = "throughput";
+
+// Fill a matrix with a well conditioned rigid transform plus a little shear
+static void benchMakeMatrix(Matrix& matrixOut, int indexIn)
+{
+	const float f = (float)indexIn;
+	Quat q;
+	q.setRotXYZ(0.37f * f, 0.11f * f + 0.5f, 0.23f * f + 1.0f);
+	matrixOut.set(q);
+	matrixOut._m1 += 0.05f;
+	matrixOut._m12 = 3.0f + f;
+	matrixOut._m13 = -2.0f * f;
+	matrixOut._m14 = 0.5f * f;
+};
+
+// Same rotation and translation as benchMakeMatrix, without the shear
+static void benchMakeTransform(RigidTransform& transformOut, int indexIn)
+{
+	const float f = (float)indexIn;
+	Quat q;
+	q.setRotXYZ(0.37f * f, 0.11f * f + 0.5f, 0.23f * f + 1.0f);
+	transformOut.set(q, Vect(3.0f + f, -2.0f * f, 0.5f * f));
+};
+
+// Time passesIn sweeps of a kernel over the set, returning nanoseconds per call
+template <typename Kernel>
+static double benchRun(const char* nameIn, int passesIn, Kernel kernel)
+{
+	const std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+	for (int pass = 0; pass < passesIn; pass++)
+	{
+		kernel();
+	}
+
+	const std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
+	const double nanoseconds = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	const double perCall = nanoseconds / ((double)passesIn * BENCH_SET_SIZE);
+
+	printf("  %-28s %8.2f ns/op %9.1f Mops/s\n", nameIn, perCall, 1000.0 / perCall);
+
+	BenchResult result;
+	result.name = nameIn;
+	result.mode = benchMode;
+	result.nsPerOp = perCall;
+	benchResults.push_back(result);
+
+	return perCall;
+};
+
+// Largest absolute difference between a matrix and the identity
+static float benchIdentityError(const Matrix& matrixIn)
+{
+	Matrix identity;
+	identity.setIdentity();
+	float error = 0.0f;
+
+	for (int i = 0; i < 16; i++)
+	{
+		const float diff = fabsf(matrixIn._m[i] - identity._m[i]);
+		if (diff > error) error = diff;
+	}
+
+	return error;
+};
+
+// Name of the backend this was built against
+static const char* benchBackend()
+{
+#if MATH_SIMD && defined(__AVX__)
+	return "SSE2, AVX for the batch kernels";
+#else
+	return MATH_SIMD ? "SSE2" : "scalar";
+#endif
+};
+
+// Name and version of the compiler this was built with
+static std::string benchCompiler()
+{
+	char buffer[128];
+#if defined(__clang__)
+	snprintf(buffer, sizeof(buffer), "clang %d.%d.%d", __clang_major__, __clang_minor__, __clang_patchlevel__);
+#elif defined(__GNUC__)
+	snprintf(buffer, sizeof(buffer), "gcc %d.%d.%d", __GNUC__, __GNUC_MINOR__, __GNUC_PATCHLEVEL__);
+#elif defined(_MSC_VER)
+	snprintf(buffer, sizeof(buffer), "msvc %d", _MSC_VER);
+#else
+	snprintf(buffer, sizeof(buffer), "unknown");
+#endif
+	return buffer;
+};
+
+// Write every result as JSON, so runs from different compilers and backends can be diffed
+static bool benchWriteJson(const char* pathIn, int passesIn)
+{
+	FILE* file = fopen(pathIn, "w");
+	if (file == 0) return false;
+
+	fprintf(file, "{\n");
+	fprintf(file, "  \"backend\": \"%s\",\n", benchBackend());
+	fprintf(file, "  \"compiler\": \"%s\",\n", benchCompiler().c_str());
+	fprintf(file, "  \"passes\": %d,\n", passesIn);
+	fprintf(file, "  \"set_size\": %d,\n", BENCH_SET_SIZE);
+	fprintf(file, "  \"results\": [\n");
+
+	for (size_t i = 0; i < benchResults.size(); i++)
+	{
+		const BenchResult& result = benchResults[i];
+		fprintf(file, "    { \"name\": \"%s\", \"mode\": \"%s\", \"ns_per_op\": %.4f, \"mops_per_sec\": %.2f }%s\n",
+			result.name.c_str(), result.mode, result.nsPerOp, 1000.0 / result.nsPerOp, i + 1 < benchResults.size() ? "," : "");
+	}
+
+	fprintf(file, "  ]\n}\n");
+	fclose(file);
+	return true;
+};
+
+// Math library microbenchmark - times the Vect, Matrix, Quat and RigidTransform kernels of whichever backend it was built against
+int main(int argc, char* argv[])
+{
+	int passes = 20000;
+	const char* jsonPath = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--passes") == 0 && i + 1 < argc) passes = atoi(argv[++i]);
+		else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonPath = argv[++i];
+		else
+		{
+			fprintf(stderr, "Usage: %s [--passes N] [--json FILE]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (passes <= 0) passes = 1;
+
+	static Matrix a[BENCH_SET_SIZE];
+	static Matrix b[BENCH_SET_SIZE];
+	static Matrix out[BENCH_SET_SIZE];
+	static Vect vects[BENCH_SET_SIZE];
+	static Vect vectsOut[BENCH_SET_SIZE];
+	static Vect units[BENCH_SET_SIZE];
+	static float scalars[BENCH_SET_SIZE];
+	static Matrix rigid[BENCH_SET_SIZE];
+	static RigidTransform ta[BENCH_SET_SIZE];
+	static RigidTransform tb[BENCH_SET_SIZE];
+	static RigidTransform tOut[BENCH_SET_SIZE];
+	static Quat quats[BENCH_SET_SIZE];
+	static Quat outQuats[BENCH_SET_SIZE];
+	static Matrix rotations[BENCH_SET_SIZE];
+	static SymMatrix inertias[BENCH_SET_SIZE];
+	static SymMatrix inertiasOut[BENCH_SET_SIZE];
+	static Vect angVelocities[BENCH_SET_SIZE];
+	static float angX[BENCH_SET_SIZE];
+	static float angY[BENCH_SET_SIZE];
+	static float angZ[BENCH_SET_SIZE];
+	static Vect3 packed[BENCH_SET_SIZE];
+	QuatBatch quatBatch;
+	quatBatch.resize(BENCH_SET_SIZE);
+
+	for (int i = 0; i < BENCH_SET_SIZE; i++)
+	{
+		benchMakeMatrix(a[i], i);
+		benchMakeMatrix(b[i], i + 7);
+		vects[i].set((float)i, 1.0f - (float)i, 0.5f * (float)i, 1.0f);
+		units[i] = Vect(1.0f + (float)(i % 5), 0.5f - (float)(i % 3), 0.25f * (float)(i % 7)).getNorm();
+		benchMakeTransform(ta[i], i);
+		benchMakeTransform(tb[i], i + 7);
+		rigid[i] = ta[i].getMatrix();
+		quats[i] = ta[i].rotation;
+		rotations[i].set(quats[i]);
+		inertias[i] = SymMatrix::diagonal(1.0f + 0.01f * (float)i, 2.0f, 0.5f + 0.02f * (float)i).getInv();
+		angVelocities[i].set(0.3f * (float)(i % 11) - 1.5f, 0.2f * (float)(i % 7), -0.1f * (float)(i % 13));
+		angX[i] = angVelocities[i][0];
+		angY[i] = angVelocities[i][1];
+		angZ[i] = angVelocities[i][2];
+		quatBatch.set(i, quats[i]);
+	}
+
+	// Accuracy check for the inverse before timing anything
+	float worstError = 0.0f;
+	for (int i = 0; i < BENCH_SET_SIZE; i++)
+	{
+		const float error = benchIdentityError(a[i] * a[i].getInv());
+		if (error > worstError) worstError = error;
+	}
+
+	printf("Math backend: %s (%s)\n", benchBackend(), benchCompiler().c_str());
+	printf("Passes: %d x %d matrices\n", passes, BENCH_SET_SIZE);
+	printf("Max |M * M^-1 - I|: %g\n", worstError);
+
+	// Same for the specialized inverses - affine on the sheared set, general and rigid on rotation plus translation
+	{
+		float affineError = 0.0f;
+		float generalRigidError = 0.0f;
+		float rigidError = 0.0f;
+		int typeMisses = 0;
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			affineError = fmaxf(affineError, benchIdentityError(a[i] * a[i].getInv(MATRIX_AFFINE)));
+			generalRigidError = fmaxf(generalRigidError, benchIdentityError(rigid[i] * rigid[i].getInv()));
+			rigidError = fmaxf(rigidError, benchIdentityError(rigid[i] * rigid[i].getInv(MATRIX_RIGID)));
+			if (a[i].getType() != MATRIX_AFFINE || rigid[i].getType() != MATRIX_RIGID) typeMisses++;
+		}
+		printf("Specialized inverses, max |M * M^-1 - I|: affine %g, rigid by getInv() %g, rigid by getInv(MATRIX_RIGID) %g, getType misses %d\n",
+			affineError, generalRigidError, rigidError, typeMisses);
+
+		// Inverting over and over, the way a long running transform chain might, and how far it wanders
+		Matrix general = rigid[BENCH_SET_SIZE - 1];
+		Matrix specialized = rigid[BENCH_SET_SIZE - 1];
+		for (int i = 0; i < 10000; i++)
+		{
+			general = general.getInv();
+			specialized = specialized.getInv(MATRIX_RIGID);
+		}
+		float generalDrift = 0.0f;
+		float specializedDrift = 0.0f;
+		for (int k = 0; k < 16; k++)
+		{
+			generalDrift = fmaxf(generalDrift, fabsf(general._m[k] - rigid[BENCH_SET_SIZE - 1]._m[k]));
+			specializedDrift = fmaxf(specializedDrift, fabsf(specialized._m[k] - rigid[BENCH_SET_SIZE - 1]._m[k]));
+		}
+		printf("Drift after 10000 inverses of a rigid matrix: getInv() %g, getInv(MATRIX_RIGID) %g\n", generalDrift, specializedDrift);
+	}
+
+	// How far a spinning body's quat strays from unit length, old per step rotation vs integrate()
+	{
+		const Vect spin(3.0f, -2.0f, 5.0f);
+		const float timeStep = 1.0f / 60.0f;
+		Quat eulerStep;
+		Quat integrated;
+		for (int i = 0; i < 100000; i++)
+		{
+			Quat q;
+			q.setRotXYZ(spin[0] * timeStep, spin[1] * timeStep, spin[2] * timeStep);
+			eulerStep = eulerStep * q;
+			integrated.integrate(spin, timeStep);
+		}
+		printf("| |q| - 1 | after 100000 steps: setRotXYZ %g, integrate %g\n",
+			fabsf(sqrtf(eulerStep.magSqr()) - 1.0f), fabsf(sqrtf(integrated.magSqr()) - 1.0f));
+	}
+
+	// Error of the fast normalize and magnitude against the precise ones, over lengths from 1e-4 to 1e4
+	{
+		float worstNorm = 0.0f;
+		float worstMag = 0.0f;
+		for (int i = 0; i < 1000000; i++)
+		{
+			const float scale = powf(10.0f, -4.0f + 8.0f * (float)i / 1000000.0f);
+			const Vect v(scale, 0.3f * scale * (float)(i % 7), -0.7f * scale);
+
+			const Vect diff = v.getNormFast() - v.getNorm();
+			const float normError = fmaxf(fabsf(diff[0]), fmaxf(fabsf(diff[1]), fabsf(diff[2])));
+			const float magError = fabsf(v.magFast() - v.mag()) / v.mag();
+			if (normError > worstNorm) worstNorm = normError;
+			if (magError > worstMag) worstMag = magError;
+		}
+		printf("Max normFast error: %g  max magFast relative error: %g\n", worstNorm, worstMag);
+	}
+
+	// The batch kernels should give the same bits as the single quat ones
+	{
+		QuatBatch check = quatBatch;
+		check.integrate(angX, angY, angZ, 1.0f / 60.0f);
+		check.getMatrices(out);
+
+		bool same = true;
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			Quat q = quats[i];
+			q.integrate(angVelocities[i], 1.0f / 60.0f);
+			Matrix m;
+			m.set(q);
+			same &= (memcmp(&m, &out[i], sizeof(Matrix)) == 0);
+			for (int k = 0; k < 4; k++) same &= (q[k] == check.get(i)[k]);
+		}
+		printf("QuatBatch matches per quat kernels: %s\n", same ? "yes" : "NO");
+	}
+
+	// Packing should round trip x, y, and z exactly (w comes back as 1)
+	{
+		Vect3::pack(vects, packed, BENCH_SET_SIZE);
+		Vect3::unpack(packed, vectsOut, BENCH_SET_SIZE);
+
+		bool same = true;
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			for (int k = 0; k < 3; k++) same &= (vectsOut[i][k] == vects[i][k] && packed[i][k] == vects[i][k]);
+			same &= (vectsOut[i][3] == 1.0f && packed[i].getVect()[3] == 1.0f);
+		}
+		printf("Vect3 (%d bytes) round trips: %s\n", (int)sizeof(Vect3), same ? "yes" : "NO");
+	}
+
+	benchRun("Vect::dot", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) scalars[i] = vects[i].dot(units[i]);
+		benchSink = benchSink + scalars[BENCH_SET_SIZE - 1];
+	});
+
+	benchRun("Vect::cross", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = vects[i].cross(units[i]);
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("Vect::mag", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) scalars[i] = vects[i].mag();
+		benchSink = benchSink + scalars[BENCH_SET_SIZE - 1];
+	});
+
+	benchRun("Matrix * Matrix", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = a[i] * b[i];
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m0;
+	});
+
+	benchRun("Matrix *= Matrix", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			// Restart from a each time so the products stay finite
+			out[i] = a[i];
+			out[i] *= b[i];
+		}
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m5;
+	});
+
+	benchRun("Vect * Matrix", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = vects[i] * a[i];
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("Matrix::getT", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = a[i].getT();
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m1;
+	});
+
+	benchRun("Matrix::T", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i].T();
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m2;
+	});
+
+	benchRun("Matrix::getInv", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = a[i].getInv();
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m3;
+	});
+
+	benchRun("Matrix::getInv(AFFINE)", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = a[i].getInv(MATRIX_AFFINE);
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m3;
+	});
+
+	benchRun("Matrix::getInv(RIGID)", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = rigid[i].getInv(MATRIX_RIGID);
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m3;
+	});
+
+	benchRun("Matrix::getInv(getType())", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = rigid[i].getInv(rigid[i].getType());
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m3;
+	});
+
+	// Rigid transforms doing the same jobs as the matrix kernels above
+	benchRun("RigidTransform compose", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) tOut[i] = ta[i] * tb[i];
+		benchSink = benchSink + tOut[BENCH_SET_SIZE - 1].translation[0];
+	});
+
+	benchRun("RigidTransform point", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = ta[i].transformPoint(vects[i]);
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("RigidTransform::getInv", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) tOut[i] = ta[i].getInv();
+		benchSink = benchSink + tOut[BENCH_SET_SIZE - 1].translation[1];
+	});
+
+	benchRun("RigidTransform inv point", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = ta[i].invTransformPoint(vects[i]);
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][1];
+	});
+
+	// Per body rotation update, the old setRotXYZ step against integrate()
+	benchRun("Quat setRotXYZ step", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			Quat q;
+			q.setRotXYZ(angVelocities[i][0] * (1.0f / 60.0f), angVelocities[i][1] * (1.0f / 60.0f), angVelocities[i][2] * (1.0f / 60.0f));
+			quats[i] = quats[i] * q;
+		}
+		benchSink = benchSink + quats[BENCH_SET_SIZE - 1][3];
+	});
+
+	benchRun("Quat * Quat", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) outQuats[i] = quats[i] * quats[BENCH_SET_SIZE - 1 - i];
+		benchSink = benchSink + outQuats[BENCH_SET_SIZE - 1][3];
+	});
+
+	benchRun("Quat::integrate", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) quats[i].integrate(angVelocities[i], 1.0f / 60.0f);
+		benchSink = benchSink + quats[BENCH_SET_SIZE - 1][3];
+	});
+
+	// Precise normalize against the rsqrt versions
+	benchRun("Vect::getNorm", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = vects[i].getNorm();
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("Vect::getNormFast", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = vects[i].getNormFast();
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("Vect::normFastArray", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = vects[i];
+		Vect::normFastArray(vectsOut, BENCH_SET_SIZE);
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	// Packed storage, whole arrays and one at a time
+	benchRun("Vect3::pack", passes, [&]()
+	{
+		Vect3::pack(vects, packed, BENCH_SET_SIZE);
+		benchSink = benchSink + packed[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("Vect3::unpack", passes, [&]()
+	{
+		Vect3::unpack(packed, vectsOut, BENCH_SET_SIZE);
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	benchRun("Vect3::getVect", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = packed[i].getVect();
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	// World space inverse inertia, the old two 4x4 products against the symmetric similarity transform
+	benchRun("Matrix R * I * R^T", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i] = rotations[i] * inertias[i].getMatrix() * rotations[i].getT();
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m1;
+	});
+
+	benchRun("SymMatrix::getRotated", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) inertiasOut[i] = inertias[i].getRotated(rotations[i]);
+		benchSink = benchSink + inertiasOut[BENCH_SET_SIZE - 1]._xy;
+	});
+
+	benchRun("Vect * SymMatrix", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) vectsOut[i] = vects[i] * inertias[i];
+		benchSink = benchSink + vectsOut[BENCH_SET_SIZE - 1][0];
+	});
+
+	// Batched rotation kernels against a loop of the single quat versions
+	benchRun("Matrix::set(Quat)", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) out[i].set(quats[i]);
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m4;
+	});
+
+	benchRun("QuatBatch::getMatrices", passes, [&]()
+	{
+		quatBatch.getMatrices(out);
+		benchSink = benchSink + out[BENCH_SET_SIZE - 1]._m4;
+	});
+
+	benchRun("QuatBatch::integrate", passes, [&]()
+	{
+		quatBatch.integrate(angX, angY, angZ, 1.0f / 60.0f);
+		benchSink = benchSink + quatBatch.w[BENCH_SET_SIZE - 1];
+	});
+
+	benchRun("Quat::norm", passes, [&]()
+	{
+		for (int i = 0; i < BENCH_SET_SIZE; i++) quats[i].norm();
+		benchSink = benchSink + quats[BENCH_SET_SIZE - 1][3];
+	});
+
+	benchRun("QuatBatch::norm", passes, [&]()
+	{
+		quatBatch.norm();
+		benchSink = benchSink + quatBatch.w[BENCH_SET_SIZE - 1];
+	});
+
+	// Dependency chains - each op needs the last one's result, so these time latency instead of throughput
+	benchMode = "latency";
+
+	benchRun("Vect::dot chain", passes, [&]()
+	{
+		// Shrinks toward a unit vector, so it stays finite however long it runs
+		Vect v = units[0];
+		for (int i = 0; i < BENCH_SET_SIZE; i++) v = units[i] * (v.dot(units[i]) * 0.5f + 0.5f);
+		benchSink = benchSink + v[0];
+	});
+
+	benchRun("Vect::cross + norm chain", passes, [&]()
+	{
+		Vect v = units[1];
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			v = v.cross(units[i]) + units[i];
+			v.norm();
+		}
+		benchSink = benchSink + v[0];
+	});
+
+	benchRun("Matrix * Matrix chain", passes, [&]()
+	{
+		// Rotations only, so the product stays a rotation
+		Matrix m = rotations[0];
+		for (int i = 0; i < BENCH_SET_SIZE; i++) m = m * rotations[i];
+		benchSink = benchSink + m._m0;
+	});
+
+	benchRun("Matrix::getInv chain", passes, [&]()
+	{
+		// Flips between a matrix and its inverse
+		Matrix m = a[0];
+		for (int i = 0; i < BENCH_SET_SIZE; i++) m = m.getInv();
+		benchSink = benchSink + m._m0;
+	});
+
+	benchRun("Quat * Quat chain", passes, [&]()
+	{
+		Quat q = quats[0];
+		for (int i = 0; i < BENCH_SET_SIZE; i++) q = q * quats[i];
+		q.norm();
+		benchSink = benchSink + q[3];
+	});
+
+	benchRun("setRotXYZ + Matrix::set chain", passes, [&]()
+	{
+		// Euler angles to a quat to a matrix, with the next angles depending on the matrix
+		Quat q;
+		Matrix m = rotations[0];
+		for (int i = 0; i < BENCH_SET_SIZE; i++)
+		{
+			q.setRotXYZ(m._m1 + angX[i], m._m2 + angY[i], angZ[i]);
+			m.set(q);
+		}
+		benchSink = benchSink + m._m0;
+	});
+
+	benchRun("Quat::integrate chain", passes, [&]()
+	{
+		Quat q = quats[0];
+		for (int i = 0; i < BENCH_SET_SIZE; i++) q.integrate(angVelocities[i], 1.0f / 60.0f);
+		benchSink = benchSink + q[3];
+	});
+
+	if (jsonPath != 0)
+	{
+		if (!benchWriteJson(jsonPath, passes))
+		{
+			fprintf(stderr, "Couldn't write %s\n", jsonPath);
+			return 1;
+		}
+		printf("Results written to %s\n", jsonPath);
+	}
+
+	return 0;
+};
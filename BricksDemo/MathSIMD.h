@@ -0,0 +1,78 @@
+#ifndef MATH_SIMD_H
+#define MATH_SIMD_H
+
+// Build switch for the math library's SIMD code
+// SSE is used whenever the compiler targets it (x64, /arch:SSE2 and up, or -msse2 and up).
+// Define MATH_NO_SIMD to force the plain scalar code instead.
+#if !defined(MATH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define MATH_SIMD 1
+#else
+	#define MATH_SIMD 0
+#endif
+
+// Math types are 16 byte aligned with or without SIMD, so both builds have the same layout
+// The SIMD code still loads and stores unaligned: most Vects live in std::vectors, and before C++17
+// (and in Visual Studio 2012's 32-bit heap) those only promise 8 byte alignment
+#if defined(_MSC_VER)
+	#define MATH_ALIGN16 __declspec(align(16))
+#else
+	#define MATH_ALIGN16 __attribute__((aligned(16)))
+#endif
+
+// Math types construct in constant expressions where the compiler supports it (Visual Studio 2015 and up)
+#if defined(_MSC_VER) && _MSC_VER < 1900
+	#define MATH_CONSTEXPR
+#else
+	#define MATH_CONSTEXPR constexpr
+#endif
+
+#if MATH_SIMD
+
+#include <emmintrin.h>
+
+// Shuffle helper - result is (a[x], a[y], a[z], a[w])
+#define MATH_SHUFFLE(a, x, y, z, w) _mm_shuffle_ps((a), (a), _MM_SHUFFLE((w), (z), (y), (x)))
+
+// Replace the w lane with 1.0f (most Vect operations reset w to 1)
+static inline __m128 simdSetWOne(const __m128 a)
+{
+	const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	return _mm_or_ps(_mm_and_ps(a, xyzMask), _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f));
+};
+
+// 3 component dot product, added up as (x + y) + z to match the scalar code bit for bit
+static inline float simdDot3(const __m128 a, const __m128 b)
+{
+	const __m128 m = _mm_mul_ps(a, b);
+	const __m128 xy = _mm_add_ss(m, MATH_SHUFFLE(m, 1, 1, 1, 1));
+	return _mm_cvtss_f32(_mm_add_ss(xy, MATH_SHUFFLE(m, 2, 2, 2, 2)));
+};
+
+// Absolute value of each lane
+static inline __m128 simdAbs(const __m128 a)
+{
+	return _mm_and_ps(a, _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff)));
+};
+
+// Reciprocal square root of each lane - the hardware estimate (about 12 bits) refined with one Newton-Raphson
+// step, y * (1.5 - 0.5 * a * y * y). Relative error stays under 5e-7 (BricksMathBench measures it), but the
+// estimate differs between CPU vendors, so results built on this aren't bit for bit portable
+static inline __m128 simdRsqrt(const __m128 a)
+{
+	const __m128 y = _mm_rsqrt_ps(a);
+	const __m128 halfA = _mm_mul_ps(_mm_set1_ps(0.5f), a);
+	return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(halfA, _mm_mul_ps(y, y))));
+};
+
+// Row vector times a 4x4 row major matrix, summed in the same order as the scalar code
+static inline __m128 simdMulRowMatrix(const __m128 a, const float* matrixIn)
+{
+	__m128 r = _mm_mul_ps(MATH_SHUFFLE(a, 0, 0, 0, 0), _mm_loadu_ps(matrixIn));
+	r = _mm_add_ps(r, _mm_mul_ps(MATH_SHUFFLE(a, 1, 1, 1, 1), _mm_loadu_ps(matrixIn + 4)));
+	r = _mm_add_ps(r, _mm_mul_ps(MATH_SHUFFLE(a, 2, 2, 2, 2), _mm_loadu_ps(matrixIn + 8)));
+	return _mm_add_ps(r, _mm_mul_ps(MATH_SHUFFLE(a, 3, 3, 3, 3), _mm_loadu_ps(matrixIn + 12)));
+};
+
+#endif // MATH_SIMD
+
+#endif
@@ -1,82 +1,8 @@
 #include "Matrix.h"
 #include <math.h>
-#include <string.h>
 #include <assert.h>
 #include "Quat.h"
 
-// Default Constructor
-Matrix::Matrix()
-	:   _m0(0.0f), _m1(0.0f), _m2(0.0f), _m3(0.0f),
-	    _m4(0.0f), _m5(0.0f), _m6(0.0f), _m7(0.0f),
-	    _m8(0.0f), _m9(0.0f), _m10(0.0f), _m11(0.0f),
-	    _m12(0.0f), _m13(0.0f), _m14(0.0f), _m15(0.0f)
-{
-}
-
-// Special constructor
-Matrix::Matrix(const Vect& vect0, const Vect& vect1, const Vect& vect2, const Vect& vect3)
-	: v0(vect0), v1(vect1), v2(vect2), v3(vect3)
-{
-}
-
-// Copy constructor
-Matrix::Matrix(const Matrix& matrixIn)
-{
-	v0 = matrixIn.v0;
-	v1 = matrixIn.v1;
-	v2 = matrixIn.v2;
-	v3 = matrixIn.v3;
-}
-
-// Assignment operator
-Matrix& Matrix::operator= (const Matrix& rhs)
-{
-    if (this != &rhs)
-	{
-        this->v0 = rhs.v0;
-        this->v1 = rhs.v1;
-        this->v2 = rhs.v2;
-        this->v3 = rhs.v3;
-	}
-
-    return *this;
-};
-
-// Matrix set function - Identity matrix
-void Matrix::setIdentity()
-{
-	memset(this, 0, sizeof(Matrix));
-	this->_m0 = 1.0f;
-	this->_m5 = 1.0f;
-	this->_m10 = 1.0f;
-	this->_m15 = 1.0f;
-};
-
-// Matrix set function - Zero matrix
-void Matrix::setZero()
-{
-	memset(this, 0, sizeof(Matrix));
-};
-
-// Set translation matrix
-void Matrix::setTrans(const float xTrans, const float yTrans, const float zTrans)
-{
-    this->setIdentity();
-    this->_m12 = xTrans;
-    this->_m13 = yTrans;
-    this->_m14 = zTrans;
-}
-
-// Set scale matrix
-void Matrix::setScale(const float xScale, const float yScale, const float zScale)
-{
-    this->setZero();
-    this->_m0 = xScale;
-    this->_m5 = yScale;
-    this->_m10 = zScale;
-    this->_m15 = 1.0f;
-}
-
 // Set rotation matrix (from rotation around X, Y, and Z axes)
 void Matrix::setRotXYZ(const float rotxIn, const float rotyIn, const float rotzIn)
 {
@@ -143,39 +69,6 @@ void Matrix::setRotAxisAngle(const Vect& axisIn, const float angleIn)
 	this->_m15 = 1.0f;
 };
 
-// Set function -  vectors
-void Matrix::set(const Vect& vect0, const Vect& vect1, const Vect& vect2, const Vect& vect3)
-{
-    this->v0 = vect0;
-    this->v1 = vect1;
-    this->v2 = vect2;
-    this->v3 = vect3;
-}
-
-// Take transpose of matrix (modifies this object)
-void Matrix::T()
-{
-    Vect col0(_m0, _m4, _m8, _m12);
-    Vect col1(_m1, _m5, _m9, _m13);
-    Vect col2(_m2, _m6, _m10, _m14);
-    Vect col3(_m3, _m7, _m11, _m15);
-
-    this->set(col0, col1, col2, col3);
-}
-
-// Return transpose of matrix (this object not modified)
-Matrix Matrix::getT() const
-{
-	Matrix returnMatrix;
-
-    returnMatrix.v0 =  Vect(_m0, _m4, _m8, _m12);
-    returnMatrix.v1 = Vect(_m1, _m5, _m9, _m13);
-    returnMatrix.v2 = Vect(_m2, _m6, _m10, _m14);
-    returnMatrix.v3 = Vect(_m3, _m7, _m11, _m15);
-
-	return returnMatrix;
-}
-
 // Determinant of matrix
 float Matrix::det() const
 {
@@ -191,6 +84,89 @@ float Matrix::det() const
 Matrix Matrix::getInv() const
 {
 	Matrix b;
+
+#if MATH_SIMD
+	// Cramer's rule on four rows at once (after Intel's AP-928)
+	// Works on the transpose, so the cofactors come out already in adjugate order
+	const float* src = &this->_m[0];
+	__m128 tmp1 = _mm_setzero_ps();
+	__m128 row0, row1, row2, row3;
+	__m128 minor0, minor1, minor2, minor3;
+	__m128 det;
+
+	tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(src)), (const __m64*)(src + 4));
+	row1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(src + 8)), (const __m64*)(src + 12));
+	row0 = _mm_shuffle_ps(tmp1, row1, 0x88);
+	row1 = _mm_shuffle_ps(row1, tmp1, 0xDD);
+	tmp1 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(src + 2)), (const __m64*)(src + 6));
+	row3 = _mm_loadh_pi(_mm_loadl_pi(tmp1, (const __m64*)(src + 10)), (const __m64*)(src + 14));
+	row2 = _mm_shuffle_ps(tmp1, row3, 0x88);
+	row3 = _mm_shuffle_ps(row3, tmp1, 0xDD);
+
+	tmp1 = _mm_mul_ps(row2, row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor0 = _mm_mul_ps(row1, tmp1);
+	minor1 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp1), minor0);
+	minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor1);
+	minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+	tmp1 = _mm_mul_ps(row1, row2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor0);
+	minor3 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp1));
+	minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor3);
+	minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+	tmp1 = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+	minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor0);
+	minor2 = _mm_mul_ps(row0, tmp1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp1));
+	minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp1), minor2);
+	minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+	tmp1 = _mm_mul_ps(row0, row1);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor2);
+	minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp1), minor3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp1), minor2);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp1));
+
+	tmp1 = _mm_mul_ps(row0, row3);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp1));
+	minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp1), minor1);
+	minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp1));
+
+	tmp1 = _mm_mul_ps(row0, row2);
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0xB1);
+	minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp1), minor1);
+	minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp1));
+	tmp1 = _mm_shuffle_ps(tmp1, tmp1, 0x4E);
+	minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp1));
+	minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp1), minor3);
+
+	// Determinant, then scale the adjugate by its reciprocal (full precision divide)
+	det = _mm_mul_ps(row0, minor0);
+	det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+	det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+	det = _mm_div_ss(_mm_set_ss(1.0f), det);
+	det = _mm_shuffle_ps(det, det, 0x00);
+
+	_mm_storeu_ps(&b._m[0], _mm_mul_ps(det, minor0));
+	_mm_storeu_ps(&b._m[4], _mm_mul_ps(det, minor1));
+	_mm_storeu_ps(&b._m[8], _mm_mul_ps(det, minor2));
+	_mm_storeu_ps(&b._m[12], _mm_mul_ps(det, minor3));
+#else
 	b._m0 = _m6*_m11*_m13 - _m7*_m10*_m13 + _m7*_m9*_m14 - _m5*_m11*_m14 - _m6*_m9*_m15 + _m5*_m10*_m15;
 	b._m1 = _m3*_m10*_m13 - _m2*_m11*_m13 - _m3*_m9*_m14 + _m1*_m11*_m14 + _m2*_m9*_m15 - _m1*_m10*_m15;
 	b._m2 = _m2*_m7*_m13 - _m3*_m6*_m13 + _m3*_m5*_m14 - _m1*_m7*_m14 - _m2*_m5*_m15 + _m1*_m6*_m15;
@@ -211,195 +187,145 @@ Matrix Matrix::getInv() const
 	float f = 1.0f / (this->det());
 
 	b *= f;
+#endif
 
 	return b;
 }
 
-// Constant indexing
-const float Matrix::operator[](const int indexIn) const
-{
-	assert(indexIn >= 0 && indexIn <= 15);
-
-	return this->_m[indexIn];
-};
+#if MATH_SIMD
 
-// Indexing for modification
-float& Matrix::operator[](const int indexIn)
+// Inverse of an affine matrix, given the rows of the inverse's 3x3 (w = 0) - the translation is run
+// backward through them, summed in the same order as the scalar code
+static inline void simdStoreAffineInv(float* matrixOut, const __m128 row0, const __m128 row1, const __m128 row2, const float* translationIn)
 {
-	assert(indexIn >= 0 && indexIn <= 15);
-
-	return this->_m[indexIn];
+	__m128 t = _mm_mul_ps(_mm_set1_ps(translationIn[0]), row0);
+	t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(translationIn[1]), row1));
+	t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(translationIn[2]), row2));
+
+	_mm_storeu_ps(matrixOut, row0);
+	_mm_storeu_ps(matrixOut + 4, row1);
+	_mm_storeu_ps(matrixOut + 8, row2);
+	_mm_storeu_ps(matrixOut + 12, simdSetWOne(_mm_xor_ps(t, _mm_set1_ps(-0.0f))));
 };
 
-// Matrix addition
-Matrix Matrix::operator+ (const Matrix& matrixIn) const
-{
-    Vect vect0(this->_m0 + matrixIn._m0, this->_m1 + matrixIn._m1, this->_m2 + matrixIn._m2, this->_m3 + matrixIn._m3);
-    Vect vect1(this->_m4 + matrixIn._m4, this->_m5 + matrixIn._m5, this->_m6 + matrixIn._m6, this->_m7 + matrixIn._m7);
-    Vect vect2(this->_m8 + matrixIn._m8, this->_m9 + matrixIn._m9, this->_m10 + matrixIn._m10, this->_m11 + matrixIn._m11);
-    Vect vect3(this->_m12 + matrixIn._m12, this->_m13 + matrixIn._m13, this->_m14 + matrixIn._m14, this->_m15 + matrixIn._m15);
+#endif
 
-    return Matrix(vect0, vect1, vect2, vect3);
-}
-
-// Matrix addition (+=)
-Matrix& Matrix::operator += (const Matrix& matrixIn)
+// Returns inverse of a matrix known to be of the given type (this object not modified)
+Matrix Matrix::getInv(const MatrixType typeIn) const
 {
-    this->_m0 += matrixIn._m0;
-    this->_m1 += matrixIn._m1;
-    this->_m2 += matrixIn._m2;
-    this->_m3 += matrixIn._m3;
-    this->_m4 += matrixIn._m4;
-    this->_m5 += matrixIn._m5;
-    this->_m6 += matrixIn._m6;
-    this->_m7 += matrixIn._m7;
-    this->_m8 += matrixIn._m8;
-    this->_m9 += matrixIn._m9;
-    this->_m10 += matrixIn._m10;
-    this->_m11 += matrixIn._m11;
-    this->_m12 += matrixIn._m12;
-    this->_m13 += matrixIn._m13;
-    this->_m14 += matrixIn._m14;
-    this->_m15 += matrixIn._m15;
-
-    return *this;
-
-}
+	Matrix b;
 
-// Matrix subtraction
-Matrix Matrix::operator- (const Matrix& matrixIn) const
-{
-    Vect vect0(this->_m0 - matrixIn._m0, this->_m1 - matrixIn._m1, this->_m2 - matrixIn._m2, this->_m3 - matrixIn._m3);
-    Vect vect1(this->_m4 - matrixIn._m4, this->_m5 - matrixIn._m5, this->_m6 - matrixIn._m6, this->_m7 - matrixIn._m7);
-    Vect vect2(this->_m8 - matrixIn._m8, this->_m9 - matrixIn._m9, this->_m10 - matrixIn._m10, this->_m11 - matrixIn._m11);
-    Vect vect3(this->_m12 - matrixIn._m12, this->_m13 - matrixIn._m13, this->_m14 - matrixIn._m14, this->_m15 - matrixIn._m15);
+	switch (typeIn)
+	{
+	case MATRIX_ORTHONORMAL:
+		// Rotation only - the inverse is the transpose
+		b = this->getT();
+		break;
 
-    return Matrix(vect0, vect1, vect2, vect3);
-}
+	case MATRIX_RIGID:
+	{
+		// Transposed rotation, then the translation run backward through it
+#if MATH_SIMD
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		__m128 row0 = _mm_and_ps(_mm_loadu_ps(&this->_m[0]), xyzMask);
+		__m128 row1 = _mm_and_ps(_mm_loadu_ps(&this->_m[4]), xyzMask);
+		__m128 row2 = _mm_and_ps(_mm_loadu_ps(&this->_m[8]), xyzMask);
+		__m128 row3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		simdStoreAffineInv(&b._m[0], row0, row1, row2, &this->_m[12]);
+#else
+		b.set(Vect(_m0, _m4, _m8, 0.0f),
+			Vect(_m1, _m5, _m9, 0.0f),
+			Vect(_m2, _m6, _m10, 0.0f),
+			Vect(-(_m12*_m0 + _m13*_m1 + _m14*_m2),
+				-(_m12*_m4 + _m13*_m5 + _m14*_m6),
+				-(_m12*_m8 + _m13*_m9 + _m14*_m10),
+				1.0f));
+#endif
+		break;
+	}
 
-// Matrix subtraction (-=)
-Matrix& Matrix::operator -= (const Matrix& matrixIn)
-{
-    this->_m0 -= matrixIn._m0;
-    this->_m1 -= matrixIn._m1;
-    this->_m2 -= matrixIn._m2;
-    this->_m3 -= matrixIn._m3;
-    this->_m4 -= matrixIn._m4;
-    this->_m5 -= matrixIn._m5;
-    this->_m6 -= matrixIn._m6;
-    this->_m7 -= matrixIn._m7;
-    this->_m8 -= matrixIn._m8;
-    this->_m9 -= matrixIn._m9;
-    this->_m10 -= matrixIn._m10;
-    this->_m11 -= matrixIn._m11;
-    this->_m12 -= matrixIn._m12;
-    this->_m13 -= matrixIn._m13;
-    this->_m14 -= matrixIn._m14;
-    this->_m15 -= matrixIn._m15;
-
-    return *this;
-}
+	case MATRIX_AFFINE:
+	{
+		// Inverse of the 3x3 from its cofactors, then the translation run backward through it
+#if MATH_SIMD
+		// Cofactors come out of cross products of the rows, a column of the inverse each
+		const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		const __m128 a0 = _mm_loadu_ps(&this->_m[0]);
+		const __m128 a1 = _mm_loadu_ps(&this->_m[4]);
+		const __m128 a2 = _mm_loadu_ps(&this->_m[8]);
+
+		__m128 row0 = _mm_sub_ps(_mm_mul_ps(MATH_SHUFFLE(a1, 1, 2, 0, 3), MATH_SHUFFLE(a2, 2, 0, 1, 3)),
+			_mm_mul_ps(MATH_SHUFFLE(a1, 2, 0, 1, 3), MATH_SHUFFLE(a2, 1, 2, 0, 3)));
+		__m128 row1 = _mm_sub_ps(_mm_mul_ps(MATH_SHUFFLE(a2, 1, 2, 0, 3), MATH_SHUFFLE(a0, 2, 0, 1, 3)),
+			_mm_mul_ps(MATH_SHUFFLE(a2, 2, 0, 1, 3), MATH_SHUFFLE(a0, 1, 2, 0, 3)));
+		__m128 row2 = _mm_sub_ps(_mm_mul_ps(MATH_SHUFFLE(a0, 1, 2, 0, 3), MATH_SHUFFLE(a1, 2, 0, 1, 3)),
+			_mm_mul_ps(MATH_SHUFFLE(a0, 2, 0, 1, 3), MATH_SHUFFLE(a1, 1, 2, 0, 3)));
+
+		const __m128 f = _mm_set1_ps(1.0f / simdDot3(a0, row0));
+		row0 = _mm_and_ps(_mm_mul_ps(row0, f), xyzMask);
+		row1 = _mm_and_ps(_mm_mul_ps(row1, f), xyzMask);
+		row2 = _mm_and_ps(_mm_mul_ps(row2, f), xyzMask);
+		__m128 row3 = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+		simdStoreAffineInv(&b._m[0], row0, row1, row2, &this->_m[12]);
+#else
+		const float c0 = _m5*_m10 - _m6*_m9;
+		const float c1 = _m6*_m8 - _m4*_m10;
+		const float c2 = _m4*_m9 - _m5*_m8;
+		const float f = 1.0f / (_m0*c0 + _m1*c1 + _m2*c2);
+
+		const float i0 = c0 * f;
+		const float i1 = (_m2*_m9 - _m1*_m10) * f;
+		const float i2 = (_m1*_m6 - _m2*_m5) * f;
+		const float i4 = c1 * f;
+		const float i5 = (_m0*_m10 - _m2*_m8) * f;
+		const float i6 = (_m2*_m4 - _m0*_m6) * f;
+		const float i8 = c2 * f;
+		const float i9 = (_m1*_m8 - _m0*_m9) * f;
+		const float i10 = (_m0*_m5 - _m1*_m4) * f;
+
+		b.set(Vect(i0, i1, i2, 0.0f),
+			Vect(i4, i5, i6, 0.0f),
+			Vect(i8, i9, i10, 0.0f),
+			Vect(-(_m12*i0 + _m13*i4 + _m14*i8),
+				-(_m12*i1 + _m13*i5 + _m14*i9),
+				-(_m12*i2 + _m13*i6 + _m14*i10),
+				1.0f));
+#endif
+		break;
+	}
 
-// Matrix multiplication
-Matrix Matrix::operator* (const Matrix& matrixIn) const
-{
-    Matrix returnMatrix;
-
-    returnMatrix._m0 = this->_m0 * matrixIn._m0 + this->_m1 * matrixIn._m4 + this->_m2 * matrixIn._m8 + this->_m3 * matrixIn._m12;
-    returnMatrix._m1 = this->_m0 * matrixIn._m1 + this->_m1 * matrixIn._m5 + this->_m2 * matrixIn._m9 + this->_m3 * matrixIn._m13;
-    returnMatrix._m2 = this->_m0 * matrixIn._m2 + this->_m1 * matrixIn._m6 + this->_m2 * matrixIn._m10 + this->_m3 * matrixIn._m14;
-    returnMatrix._m3 = this->_m0 * matrixIn._m3 + this->_m1 * matrixIn._m7 + this->_m2 * matrixIn._m11 + this->_m3 * matrixIn._m15;
-
-    returnMatrix._m4 = this->_m4 * matrixIn._m0 + this->_m5 * matrixIn._m4 + this->_m6 * matrixIn._m8 + this->_m7 * matrixIn._m12;
-    returnMatrix._m5 = this->_m4 * matrixIn._m1 + this->_m5 * matrixIn._m5 + this->_m6 * matrixIn._m9 + this->_m7 * matrixIn._m13;
-    returnMatrix._m6 = this->_m4 * matrixIn._m2 + this->_m5 * matrixIn._m6 + this->_m6 * matrixIn._m10 + this->_m7 * matrixIn._m14;
-    returnMatrix._m7 = this->_m4 * matrixIn._m3 + this->_m5 * matrixIn._m7 + this->_m6 * matrixIn._m11 + this->_m7 * matrixIn._m15;
-    
-    returnMatrix._m8 = this->_m8 * matrixIn._m0 + this->_m9 * matrixIn._m4 + this->_m10 * matrixIn._m8 + this->_m11 * matrixIn._m12;
-    returnMatrix._m9 = this->_m8 * matrixIn._m1 + this->_m9 * matrixIn._m5 + this->_m10 * matrixIn._m9 + this->_m11 * matrixIn._m13;
-    returnMatrix._m10 = this->_m8 * matrixIn._m2 + this->_m9 * matrixIn._m6 + this->_m10 * matrixIn._m10 + this->_m11 * matrixIn._m14;
-    returnMatrix._m11 = this->_m8 * matrixIn._m3 + this->_m9 * matrixIn._m7 + this->_m10 * matrixIn._m11 + this->_m11 * matrixIn._m15;
-
-    returnMatrix._m12 = this->_m12 * matrixIn._m0 + this->_m13 * matrixIn._m4 + this->_m14 * matrixIn._m8 + this->_m15 * matrixIn._m12;
-    returnMatrix._m13 = this->_m12 * matrixIn._m1 + this->_m13 * matrixIn._m5 + this->_m14 * matrixIn._m9 + this->_m15 * matrixIn._m13;
-    returnMatrix._m14 = this->_m12 * matrixIn._m2 + this->_m13 * matrixIn._m6 + this->_m14 * matrixIn._m10 + this->_m15 * matrixIn._m14;
-    returnMatrix._m15 = this->_m12 * matrixIn._m3 + this->_m13 * matrixIn._m7 + this->_m14 * matrixIn._m11 + this->_m15 * matrixIn._m15;
-
-    return returnMatrix;
-};
+	default:
+		b = this->getInv();
+		break;
+	}
 
-// Matrix multiplication (*=)
-Matrix& Matrix::operator*= (const Matrix& matrixIn)
-{
-    Matrix matrix;
-    matrix._m0 = this->_m0 * matrixIn._m0 + this->_m1 * matrixIn._m4 + this->_m2 * matrixIn._m8 + this->_m3 * matrixIn._m12;
-    matrix._m1 = this->_m0 * matrixIn._m1 + this->_m1 * matrixIn._m5 + this->_m2 * matrixIn._m9 + this->_m3 * matrixIn._m13;
-    matrix._m2 = this->_m0 * matrixIn._m2 + this->_m1 * matrixIn._m6 + this->_m2 * matrixIn._m10 + this->_m3 * matrixIn._m14;
-    matrix._m3 = this->_m0 * matrixIn._m3 + this->_m1 * matrixIn._m7 + this->_m2 * matrixIn._m11 + this->_m3 * matrixIn._m15;
-
-    matrix._m4 = this->_m4 * matrixIn._m0 + this->_m5 * matrixIn._m4 + this->_m6 * matrixIn._m8 + this->_m7 * matrixIn._m12;
-    matrix._m5 = this->_m4 * matrixIn._m1 + this->_m5 * matrixIn._m5 + this->_m6 * matrixIn._m9 + this->_m7 * matrixIn._m13;
-    matrix._m6 = this->_m4 * matrixIn._m2 + this->_m5 * matrixIn._m6 + this->_m6 * matrixIn._m10 + this->_m7 * matrixIn._m14;
-    matrix._m7 = this->_m4 * matrixIn._m3 + this->_m5 * matrixIn._m7 + this->_m6 * matrixIn._m11 + this->_m7 * matrixIn._m15;
-    
-    matrix._m8 = this->_m8 * matrixIn._m0 + this->_m9 * matrixIn._m4 + this->_m10 * matrixIn._m8 + this->_m11 * matrixIn._m12;
-    matrix._m9 = this->_m8 * matrixIn._m1 + this->_m9 * matrixIn._m5 + this->_m10 * matrixIn._m9 + this->_m11 * matrixIn._m13;
-    matrix._m10 = this->_m8 * matrixIn._m2 + this->_m9 * matrixIn._m6 + this->_m10 * matrixIn._m10 + this->_m11 * matrixIn._m14;
-    matrix._m11 = this->_m8 * matrixIn._m3 + this->_m9 * matrixIn._m7 + this->_m10 * matrixIn._m11 + this->_m11 * matrixIn._m15;
-
-    matrix._m12 = this->_m12 * matrixIn._m0 + this->_m13 * matrixIn._m4 + this->_m14 * matrixIn._m8 + this->_m15 * matrixIn._m12;
-    matrix._m13 = this->_m12 * matrixIn._m1 + this->_m13 * matrixIn._m5 + this->_m14 * matrixIn._m9 + this->_m15 * matrixIn._m13;
-    matrix._m14 = this->_m12 * matrixIn._m2 + this->_m13 * matrixIn._m6 + this->_m14 * matrixIn._m10 + this->_m15 * matrixIn._m14;
-    matrix._m15 = this->_m12 * matrixIn._m3 + this->_m13 * matrixIn._m7 + this->_m14 * matrixIn._m11 + this->_m15 * matrixIn._m15;
-
-    *this = matrix;
-
-    return *this;
+	return b;
 }
 
-// Multiplying by scalar (friend function)
-Matrix operator * (const float s, const Matrix& matrixIn)
+// Most specialized type this matrix fits
+MatrixType Matrix::getType(const float tolerance) const
 {
-    Vect vect0(s * matrixIn._m0, s * matrixIn._m1, s * matrixIn._m2, s * matrixIn._m3);
-    Vect vect1(s * matrixIn._m4, s * matrixIn._m5, s * matrixIn._m6, s * matrixIn._m7);
-    Vect vect2(s * matrixIn._m8, s * matrixIn._m9, s * matrixIn._m10, s * matrixIn._m11);
-    Vect vect3(s * matrixIn._m12, s * matrixIn._m13, s * matrixIn._m14, s * matrixIn._m15);
+	// Anything with a projective part needs the full inverse
+	if (_m3 != 0.0f || _m7 != 0.0f || _m11 != 0.0f || _m15 != 1.0f) return MATRIX_GENERAL;
 
-    return Matrix(vect0, vect1, vect2, vect3);
-}
+	// Rows 0-2 unit length and at right angles to each other (their w is 0, so whole rows work)
+	const bool orthonormal =
+		fabsf(this->v[0].magSqr() - 1.0f) <= tolerance &&
+		fabsf(this->v[1].magSqr() - 1.0f) <= tolerance &&
+		fabsf(this->v[2].magSqr() - 1.0f) <= tolerance &&
+		fabsf(this->v[0].dot(this->v[1])) <= tolerance &&
+		fabsf(this->v[0].dot(this->v[2])) <= tolerance &&
+		fabsf(this->v[1].dot(this->v[2])) <= tolerance;
 
-// Multiplying by scalar
-Matrix Matrix::operator* (const float s) const
-{
-    Vect vect0(s * this->_m0, s * this->_m1, s * this->_m2, s * this->_m3);
-    Vect vect1(s * this->_m4, s * this->_m5, s * this->_m6, s * this->_m7);
-    Vect vect2(s * this->_m8, s * this->_m9, s * this->_m10, s * this->_m11);
-    Vect vect3(s * this->_m12, s * this->_m13, s * this->_m14, s * this->_m15);
+	if (!orthonormal) return MATRIX_AFFINE;
 
-    return Matrix(vect0, vect1, vect2, vect3);
-}
+	if (_m12 != 0.0f || _m13 != 0.0f || _m14 != 0.0f) return MATRIX_RIGID;
 
-// Multiplying by scalar (*=)
-Matrix& Matrix::operator*= (const float s)
-{
-    this->_m0 *= s;
-    this->_m1 *= s;
-    this->_m2 *= s;
-    this->_m3 *= s;
-    this->_m4 *= s;
-    this->_m5 *= s;
-    this->_m6 *= s;
-    this->_m7 *= s;
-    this->_m8 *= s;
-    this->_m9 *= s;
-    this->_m10 *= s;
-    this->_m11 *= s;
-    this->_m12 *= s;
-    this->_m13 *= s;
-    this->_m14 *= s;
-    this->_m15 *= s;
-
-    return *this;
+	return MATRIX_ORTHONORMAL;
 }
 
 // Set function (create rotation matrix from quat)
@@ -430,4 +356,3 @@ void Matrix::set(const Quat& quatIn)
 	this->_m14 = 0.0f;
 	this->_m15 = 1.0f;
 };
-
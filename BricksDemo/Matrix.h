@@ -5,23 +5,50 @@
 
 class Quat;
 
+// What a matrix is known to be, from most general to most specialized, so getInv can take a shortcut
+enum MatrixType
+{
+	MATRIX_GENERAL,		// Any invertible matrix
+	MATRIX_AFFINE,		// Last column (0, 0, 0, 1) - any 3x3 (rotation, scale, shear) plus a translation
+	MATRIX_RIGID,		// Affine with orthonormal rows 0-2 - rotation plus translation
+	MATRIX_ORTHONORMAL	// Rigid with no translation - rotation only
+};
+
 class Matrix
 {
 public:
 	friend class Vect;
 
-    // Constructors
-    Matrix();
-    Matrix(const Vect& vect0, const Vect& vect1, const Vect& vect2, const Vect& vect3);
+    // Constructors (copy, assignment and destructor are the compiler's trivial ones)
+    MATH_CONSTEXPR Matrix()
+	:   _m0(0.0f), _m1(0.0f), _m2(0.0f), _m3(0.0f),
+	    _m4(0.0f), _m5(0.0f), _m6(0.0f), _m7(0.0f),
+	    _m8(0.0f), _m9(0.0f), _m10(0.0f), _m11(0.0f),
+	    _m12(0.0f), _m13(0.0f), _m14(0.0f), _m15(0.0f)
+    {
+    }
 
-public:
-    Matrix(const Matrix& matrixIn);
-    
-    // Assignment operator
-    Matrix& operator=( const Matrix& rhs);
+    MATH_CONSTEXPR Matrix(const Vect& vect0, const Vect& vect1, const Vect& vect2, const Vect& vect3)
+	:   _m0(vect0.vx), _m1(vect0.vy), _m2(vect0.vz), _m3(vect0.vw),
+	    _m4(vect1.vx), _m5(vect1.vy), _m6(vect1.vz), _m7(vect1.vw),
+	    _m8(vect2.vx), _m9(vect2.vy), _m10(vect2.vz), _m11(vect2.vw),
+	    _m12(vect3.vx), _m13(vect3.vy), _m14(vect3.vz), _m15(vect3.vw)
+    {
+    }
+
+    // Identity and zero matrices
+    static MATH_CONSTEXPR Matrix identity()
+    {
+        return Matrix(Vect(1.0f, 0.0f, 0.0f, 0.0f),
+            Vect(0.0f, 1.0f, 0.0f, 0.0f),
+            Vect(0.0f, 0.0f, 1.0f, 0.0f),
+            Vect(0.0f, 0.0f, 0.0f, 1.0f));
+    }
 
-    // Destructor
-	~Matrix() { }
+    static MATH_CONSTEXPR Matrix zero()
+    {
+        return Matrix();
+    }
 
     // Matrix set functions
     void setZero();
@@ -41,6 +68,16 @@ public:
 	float det() const;
 	Matrix getInv() const;
 
+	// Inverse for a matrix known to be of the given type - affine inverts just the 3x3, rigid and
+	// orthonormal transpose it (cheaper, and exact up to rounding instead of going through a determinant)
+	// Nothing in the simulation inverts a Matrix (the inertia tensors are SymMatrix), so for now only
+	// BricksMathBench uses these
+	Matrix getInv(const MatrixType typeIn) const;
+
+	// Most specialized type this matrix fits (rows checked for orthonormality within the tolerance),
+	// so getInv(m.getType()) picks the cheapest correct inverse
+	MatrixType getType(const float tolerance = 0.00001f) const;
+
     // Overloaded bracket operators for getting
     const float operator[](const int indexIn) const;
 
@@ -66,18 +103,7 @@ public:
 
 	// Different ways to look at the data
 	union {
-		struct 
-		{
-			Vect v0;
-			Vect v1;
-			Vect v2;
-			Vect v3;
-		};
-
-		struct
-		{
-			Vect v[4];
-		};
+		Vect v[4];
 
 		struct 
 		{
@@ -107,4 +133,340 @@ public:
 	};
 };
 
+// Matrix set function - Identity matrix
+inline void Matrix::setIdentity()
+{
+	*this = Matrix::identity();
+};
+
+// Matrix set function - Zero matrix
+inline void Matrix::setZero()
+{
+	*this = Matrix();
+};
+
+// Set translation matrix
+inline void Matrix::setTrans(const float xTrans, const float yTrans, const float zTrans)
+{
+    this->setIdentity();
+    this->_m12 = xTrans;
+    this->_m13 = yTrans;
+    this->_m14 = zTrans;
+}
+
+// Set scale matrix
+inline void Matrix::setScale(const float xScale, const float yScale, const float zScale)
+{
+    this->setZero();
+    this->_m0 = xScale;
+    this->_m5 = yScale;
+    this->_m10 = zScale;
+    this->_m15 = 1.0f;
+}
+
+// Set function -  vectors
+inline void Matrix::set(const Vect& vect0, const Vect& vect1, const Vect& vect2, const Vect& vect3)
+{
+    this->v[0] = vect0;
+    this->v[1] = vect1;
+    this->v[2] = vect2;
+    this->v[3] = vect3;
+}
+
+// Take transpose of matrix (modifies this object)
+inline void Matrix::T()
+{
+#if MATH_SIMD
+    __m128 row0 = _mm_loadu_ps(&this->_m[0]);
+    __m128 row1 = _mm_loadu_ps(&this->_m[4]);
+    __m128 row2 = _mm_loadu_ps(&this->_m[8]);
+    __m128 row3 = _mm_loadu_ps(&this->_m[12]);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(&this->_m[0], row0);
+    _mm_storeu_ps(&this->_m[4], row1);
+    _mm_storeu_ps(&this->_m[8], row2);
+    _mm_storeu_ps(&this->_m[12], row3);
+#else
+    Vect col0(_m0, _m4, _m8, _m12);
+    Vect col1(_m1, _m5, _m9, _m13);
+    Vect col2(_m2, _m6, _m10, _m14);
+    Vect col3(_m3, _m7, _m11, _m15);
+
+    this->set(col0, col1, col2, col3);
+#endif
+}
+
+// Return transpose of matrix (this object not modified)
+inline Matrix Matrix::getT() const
+{
+	Matrix returnMatrix;
+
+#if MATH_SIMD
+    __m128 row0 = _mm_loadu_ps(&this->_m[0]);
+    __m128 row1 = _mm_loadu_ps(&this->_m[4]);
+    __m128 row2 = _mm_loadu_ps(&this->_m[8]);
+    __m128 row3 = _mm_loadu_ps(&this->_m[12]);
+    _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+    _mm_storeu_ps(&returnMatrix._m[0], row0);
+    _mm_storeu_ps(&returnMatrix._m[4], row1);
+    _mm_storeu_ps(&returnMatrix._m[8], row2);
+    _mm_storeu_ps(&returnMatrix._m[12], row3);
+#else
+    returnMatrix.v[0] =  Vect(_m0, _m4, _m8, _m12);
+    returnMatrix.v[1] = Vect(_m1, _m5, _m9, _m13);
+    returnMatrix.v[2] = Vect(_m2, _m6, _m10, _m14);
+    returnMatrix.v[3] = Vect(_m3, _m7, _m11, _m15);
+#endif
+
+	return returnMatrix;
+}
+
+// Constant indexing
+inline const float Matrix::operator[](const int indexIn) const
+{
+	assert(indexIn >= 0 && indexIn <= 15);
+
+	return this->_m[indexIn];
+};
+
+// Indexing for modification
+inline float& Matrix::operator[](const int indexIn)
+{
+	assert(indexIn >= 0 && indexIn <= 15);
+
+	return this->_m[indexIn];
+};
+
+// Matrix addition
+inline Matrix Matrix::operator+ (const Matrix& matrixIn) const
+{
+    Vect vect0(this->_m0 + matrixIn._m0, this->_m1 + matrixIn._m1, this->_m2 + matrixIn._m2, this->_m3 + matrixIn._m3);
+    Vect vect1(this->_m4 + matrixIn._m4, this->_m5 + matrixIn._m5, this->_m6 + matrixIn._m6, this->_m7 + matrixIn._m7);
+    Vect vect2(this->_m8 + matrixIn._m8, this->_m9 + matrixIn._m9, this->_m10 + matrixIn._m10, this->_m11 + matrixIn._m11);
+    Vect vect3(this->_m12 + matrixIn._m12, this->_m13 + matrixIn._m13, this->_m14 + matrixIn._m14, this->_m15 + matrixIn._m15);
+
+    return Matrix(vect0, vect1, vect2, vect3);
+}
+
+// Matrix addition (+=)
+inline Matrix& Matrix::operator += (const Matrix& matrixIn)
+{
+    this->_m0 += matrixIn._m0;
+    this->_m1 += matrixIn._m1;
+    this->_m2 += matrixIn._m2;
+    this->_m3 += matrixIn._m3;
+    this->_m4 += matrixIn._m4;
+    this->_m5 += matrixIn._m5;
+    this->_m6 += matrixIn._m6;
+    this->_m7 += matrixIn._m7;
+    this->_m8 += matrixIn._m8;
+    this->_m9 += matrixIn._m9;
+    this->_m10 += matrixIn._m10;
+    this->_m11 += matrixIn._m11;
+    this->_m12 += matrixIn._m12;
+    this->_m13 += matrixIn._m13;
+    this->_m14 += matrixIn._m14;
+    this->_m15 += matrixIn._m15;
+
+    return *this;
+
+}
+
+// Matrix subtraction
+inline Matrix Matrix::operator- (const Matrix& matrixIn) const
+{
+    Vect vect0(this->_m0 - matrixIn._m0, this->_m1 - matrixIn._m1, this->_m2 - matrixIn._m2, this->_m3 - matrixIn._m3);
+    Vect vect1(this->_m4 - matrixIn._m4, this->_m5 - matrixIn._m5, this->_m6 - matrixIn._m6, this->_m7 - matrixIn._m7);
+    Vect vect2(this->_m8 - matrixIn._m8, this->_m9 - matrixIn._m9, this->_m10 - matrixIn._m10, this->_m11 - matrixIn._m11);
+    Vect vect3(this->_m12 - matrixIn._m12, this->_m13 - matrixIn._m13, this->_m14 - matrixIn._m14, this->_m15 - matrixIn._m15);
+
+    return Matrix(vect0, vect1, vect2, vect3);
+}
+
+// Matrix subtraction (-=)
+inline Matrix& Matrix::operator -= (const Matrix& matrixIn)
+{
+    this->_m0 -= matrixIn._m0;
+    this->_m1 -= matrixIn._m1;
+    this->_m2 -= matrixIn._m2;
+    this->_m3 -= matrixIn._m3;
+    this->_m4 -= matrixIn._m4;
+    this->_m5 -= matrixIn._m5;
+    this->_m6 -= matrixIn._m6;
+    this->_m7 -= matrixIn._m7;
+    this->_m8 -= matrixIn._m8;
+    this->_m9 -= matrixIn._m9;
+    this->_m10 -= matrixIn._m10;
+    this->_m11 -= matrixIn._m11;
+    this->_m12 -= matrixIn._m12;
+    this->_m13 -= matrixIn._m13;
+    this->_m14 -= matrixIn._m14;
+    this->_m15 -= matrixIn._m15;
+
+    return *this;
+}
+
+// Matrix multiplication
+inline Matrix Matrix::operator* (const Matrix& matrixIn) const
+{
+    Matrix returnMatrix;
+
+#if MATH_SIMD
+    // Each row of the result is that row of this matrix times matrixIn
+    _mm_storeu_ps(&returnMatrix._m[0], simdMulRowMatrix(_mm_loadu_ps(&this->_m[0]), &matrixIn._m[0]));
+    _mm_storeu_ps(&returnMatrix._m[4], simdMulRowMatrix(_mm_loadu_ps(&this->_m[4]), &matrixIn._m[0]));
+    _mm_storeu_ps(&returnMatrix._m[8], simdMulRowMatrix(_mm_loadu_ps(&this->_m[8]), &matrixIn._m[0]));
+    _mm_storeu_ps(&returnMatrix._m[12], simdMulRowMatrix(_mm_loadu_ps(&this->_m[12]), &matrixIn._m[0]));
+#else
+
+    returnMatrix._m0 = this->_m0 * matrixIn._m0 + this->_m1 * matrixIn._m4 + this->_m2 * matrixIn._m8 + this->_m3 * matrixIn._m12;
+    returnMatrix._m1 = this->_m0 * matrixIn._m1 + this->_m1 * matrixIn._m5 + this->_m2 * matrixIn._m9 + this->_m3 * matrixIn._m13;
+    returnMatrix._m2 = this->_m0 * matrixIn._m2 + this->_m1 * matrixIn._m6 + this->_m2 * matrixIn._m10 + this->_m3 * matrixIn._m14;
+    returnMatrix._m3 = this->_m0 * matrixIn._m3 + this->_m1 * matrixIn._m7 + this->_m2 * matrixIn._m11 + this->_m3 * matrixIn._m15;
+
+    returnMatrix._m4 = this->_m4 * matrixIn._m0 + this->_m5 * matrixIn._m4 + this->_m6 * matrixIn._m8 + this->_m7 * matrixIn._m12;
+    returnMatrix._m5 = this->_m4 * matrixIn._m1 + this->_m5 * matrixIn._m5 + this->_m6 * matrixIn._m9 + this->_m7 * matrixIn._m13;
+    returnMatrix._m6 = this->_m4 * matrixIn._m2 + this->_m5 * matrixIn._m6 + this->_m6 * matrixIn._m10 + this->_m7 * matrixIn._m14;
+    returnMatrix._m7 = this->_m4 * matrixIn._m3 + this->_m5 * matrixIn._m7 + this->_m6 * matrixIn._m11 + this->_m7 * matrixIn._m15;
+    
+    returnMatrix._m8 = this->_m8 * matrixIn._m0 + this->_m9 * matrixIn._m4 + this->_m10 * matrixIn._m8 + this->_m11 * matrixIn._m12;
+    returnMatrix._m9 = this->_m8 * matrixIn._m1 + this->_m9 * matrixIn._m5 + this->_m10 * matrixIn._m9 + this->_m11 * matrixIn._m13;
+    returnMatrix._m10 = this->_m8 * matrixIn._m2 + this->_m9 * matrixIn._m6 + this->_m10 * matrixIn._m10 + this->_m11 * matrixIn._m14;
+    returnMatrix._m11 = this->_m8 * matrixIn._m3 + this->_m9 * matrixIn._m7 + this->_m10 * matrixIn._m11 + this->_m11 * matrixIn._m15;
+
+    returnMatrix._m12 = this->_m12 * matrixIn._m0 + this->_m13 * matrixIn._m4 + this->_m14 * matrixIn._m8 + this->_m15 * matrixIn._m12;
+    returnMatrix._m13 = this->_m12 * matrixIn._m1 + this->_m13 * matrixIn._m5 + this->_m14 * matrixIn._m9 + this->_m15 * matrixIn._m13;
+    returnMatrix._m14 = this->_m12 * matrixIn._m2 + this->_m13 * matrixIn._m6 + this->_m14 * matrixIn._m10 + this->_m15 * matrixIn._m14;
+    returnMatrix._m15 = this->_m12 * matrixIn._m3 + this->_m13 * matrixIn._m7 + this->_m14 * matrixIn._m11 + this->_m15 * matrixIn._m15;
+#endif
+
+    return returnMatrix;
+};
+
+// Matrix multiplication (*=)
+inline Matrix& Matrix::operator*= (const Matrix& matrixIn)
+{
+#if MATH_SIMD
+    // Load all our rows first in case matrixIn is this matrix
+    const __m128 row0 = _mm_loadu_ps(&this->_m[0]);
+    const __m128 row1 = _mm_loadu_ps(&this->_m[4]);
+    const __m128 row2 = _mm_loadu_ps(&this->_m[8]);
+    const __m128 row3 = _mm_loadu_ps(&this->_m[12]);
+    const __m128 res0 = simdMulRowMatrix(row0, &matrixIn._m[0]);
+    const __m128 res1 = simdMulRowMatrix(row1, &matrixIn._m[0]);
+    const __m128 res2 = simdMulRowMatrix(row2, &matrixIn._m[0]);
+    const __m128 res3 = simdMulRowMatrix(row3, &matrixIn._m[0]);
+    _mm_storeu_ps(&this->_m[0], res0);
+    _mm_storeu_ps(&this->_m[4], res1);
+    _mm_storeu_ps(&this->_m[8], res2);
+    _mm_storeu_ps(&this->_m[12], res3);
+#else
+    Matrix matrix;
+    matrix._m0 = this->_m0 * matrixIn._m0 + this->_m1 * matrixIn._m4 + this->_m2 * matrixIn._m8 + this->_m3 * matrixIn._m12;
+    matrix._m1 = this->_m0 * matrixIn._m1 + this->_m1 * matrixIn._m5 + this->_m2 * matrixIn._m9 + this->_m3 * matrixIn._m13;
+    matrix._m2 = this->_m0 * matrixIn._m2 + this->_m1 * matrixIn._m6 + this->_m2 * matrixIn._m10 + this->_m3 * matrixIn._m14;
+    matrix._m3 = this->_m0 * matrixIn._m3 + this->_m1 * matrixIn._m7 + this->_m2 * matrixIn._m11 + this->_m3 * matrixIn._m15;
+
+    matrix._m4 = this->_m4 * matrixIn._m0 + this->_m5 * matrixIn._m4 + this->_m6 * matrixIn._m8 + this->_m7 * matrixIn._m12;
+    matrix._m5 = this->_m4 * matrixIn._m1 + this->_m5 * matrixIn._m5 + this->_m6 * matrixIn._m9 + this->_m7 * matrixIn._m13;
+    matrix._m6 = this->_m4 * matrixIn._m2 + this->_m5 * matrixIn._m6 + this->_m6 * matrixIn._m10 + this->_m7 * matrixIn._m14;
+    matrix._m7 = this->_m4 * matrixIn._m3 + this->_m5 * matrixIn._m7 + this->_m6 * matrixIn._m11 + this->_m7 * matrixIn._m15;
+    
+    matrix._m8 = this->_m8 * matrixIn._m0 + this->_m9 * matrixIn._m4 + this->_m10 * matrixIn._m8 + this->_m11 * matrixIn._m12;
+    matrix._m9 = this->_m8 * matrixIn._m1 + this->_m9 * matrixIn._m5 + this->_m10 * matrixIn._m9 + this->_m11 * matrixIn._m13;
+    matrix._m10 = this->_m8 * matrixIn._m2 + this->_m9 * matrixIn._m6 + this->_m10 * matrixIn._m10 + this->_m11 * matrixIn._m14;
+    matrix._m11 = this->_m8 * matrixIn._m3 + this->_m9 * matrixIn._m7 + this->_m10 * matrixIn._m11 + this->_m11 * matrixIn._m15;
+
+    matrix._m12 = this->_m12 * matrixIn._m0 + this->_m13 * matrixIn._m4 + this->_m14 * matrixIn._m8 + this->_m15 * matrixIn._m12;
+    matrix._m13 = this->_m12 * matrixIn._m1 + this->_m13 * matrixIn._m5 + this->_m14 * matrixIn._m9 + this->_m15 * matrixIn._m13;
+    matrix._m14 = this->_m12 * matrixIn._m2 + this->_m13 * matrixIn._m6 + this->_m14 * matrixIn._m10 + this->_m15 * matrixIn._m14;
+    matrix._m15 = this->_m12 * matrixIn._m3 + this->_m13 * matrixIn._m7 + this->_m14 * matrixIn._m11 + this->_m15 * matrixIn._m15;
+
+    *this = matrix;
+#endif
+
+    return *this;
+}
+
+// Multiplying by scalar (friend function)
+inline Matrix operator * (const float s, const Matrix& matrixIn)
+{
+    Vect vect0(s * matrixIn._m0, s * matrixIn._m1, s * matrixIn._m2, s * matrixIn._m3);
+    Vect vect1(s * matrixIn._m4, s * matrixIn._m5, s * matrixIn._m6, s * matrixIn._m7);
+    Vect vect2(s * matrixIn._m8, s * matrixIn._m9, s * matrixIn._m10, s * matrixIn._m11);
+    Vect vect3(s * matrixIn._m12, s * matrixIn._m13, s * matrixIn._m14, s * matrixIn._m15);
+
+    return Matrix(vect0, vect1, vect2, vect3);
+}
+
+// Multiplying by scalar
+inline Matrix Matrix::operator* (const float s) const
+{
+    Vect vect0(s * this->_m0, s * this->_m1, s * this->_m2, s * this->_m3);
+    Vect vect1(s * this->_m4, s * this->_m5, s * this->_m6, s * this->_m7);
+    Vect vect2(s * this->_m8, s * this->_m9, s * this->_m10, s * this->_m11);
+    Vect vect3(s * this->_m12, s * this->_m13, s * this->_m14, s * this->_m15);
+
+    return Matrix(vect0, vect1, vect2, vect3);
+}
+
+// Multiplying by scalar (*=)
+inline Matrix& Matrix::operator*= (const float s)
+{
+    this->_m0 *= s;
+    this->_m1 *= s;
+    this->_m2 *= s;
+    this->_m3 *= s;
+    this->_m4 *= s;
+    this->_m5 *= s;
+    this->_m6 *= s;
+    this->_m7 *= s;
+    this->_m8 *= s;
+    this->_m9 *= s;
+    this->_m10 *= s;
+    this->_m11 *= s;
+    this->_m12 *= s;
+    this->_m13 *= s;
+    this->_m14 *= s;
+    this->_m15 *= s;
+
+    return *this;
+}
+
+// Multiplication by matrix
+inline Vect Vect::operator*(const Matrix& matrixIn) const
+{
+    Vect returnVect;
+
+#if MATH_SIMD
+    _mm_storeu_ps(returnVect.v, simdMulRowMatrix(_mm_loadu_ps(this->v), &matrixIn._m[0]));
+#else
+    returnVect.vx = this->vx * matrixIn[0] + this->vy * matrixIn[4] + this->vz * matrixIn[8] + this->vw * matrixIn[12];
+    returnVect.vy = this->vx * matrixIn[1] + this->vy * matrixIn[5] + this->vz * matrixIn[9] + this->vw * matrixIn[13];
+    returnVect.vz = this->vx * matrixIn[2] + this->vy * matrixIn[6] + this->vz * matrixIn[10] + this->vw * matrixIn[14];
+    returnVect.vw = this->vx * matrixIn[3] + this->vy * matrixIn[7] + this->vz * matrixIn[11] + this->vw * matrixIn[15];
+#endif
+
+    return returnVect;
+}
+
+// Multiplication by matrix (*=)
+inline Vect& Vect::operator*=(const Matrix& matrixIn)
+{
+#if MATH_SIMD
+    _mm_storeu_ps(this->v, simdMulRowMatrix(_mm_loadu_ps(this->v), &matrixIn._m[0]));
+#else
+    Vect returnVect;
+
+    returnVect.vx = this->vx * matrixIn[0] + this->vy * matrixIn[4] + this->vz * matrixIn[8] + this->vw * matrixIn[12];
+    returnVect.vy = this->vx * matrixIn[1] + this->vy * matrixIn[5] + this->vz * matrixIn[9] + this->vw * matrixIn[13];
+    returnVect.vz = this->vx * matrixIn[2] + this->vy * matrixIn[6] + this->vz * matrixIn[10] + this->vw * matrixIn[14];
+    returnVect.vw = this->vx * matrixIn[3] + this->vy * matrixIn[7] + this->vz * matrixIn[11] + this->vw * matrixIn[15];
+
+    *this = returnVect;
+#endif
+
+    return *this;
+}
+
 #endif
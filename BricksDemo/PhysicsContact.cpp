@@ -22,6 +22,43 @@ PhysicsContact::~PhysicsContact()
 {
 };
 
+// Clear the contact
+void ContactManifold::Reset()
+{
+	this->normal.set(0.0f, 0.0f, 0.0f);
+	this->numPoints = 0;
+	this->penetration = 0.0f;
+	this->blocks[0] = 0;
+	this->blocks[1] = 0;
+};
+
+// Resolve a whole manifold, one point at a time
+void PhysicsContact::ResolveManifold(const ContactManifold& manifoldIn, const float timeIn)
+{
+	for (int p = 0; p < manifoldIn.numPoints; p++)
+	{
+		this->normal = manifoldIn.normal;
+		this->contactPoint = manifoldIn.points[p];
+		this->penetration = manifoldIn.penetrations[p];
+		this->blocks[0] = manifoldIn.blocks[0];
+		this->blocks[1] = manifoldIn.blocks[1];
+
+		// Each point sees the velocities the points before it left behind
+		this->CalculateData(timeIn);
+
+		// A point that's already moving apart needs no impulse - it would only pull the blocks together
+		if (this->desiredVelocityChange > 0.0f)
+		{
+			this->ChangeVelocity();
+		}
+	}
+
+	// The blocks only need moving apart once, by the deepest penetration
+	this->penetration = manifoldIn.penetration;
+	this->ChangePosition();
+	this->Reset();
+};
+
 // Calculate the velocity change we need (at the contact point)
 void PhysicsContact::CalculateDesiredVelocityChange(const float timeIn)
 {
@@ -38,11 +75,11 @@ void PhysicsContact::CalculateDesiredVelocityChange(const float timeIn)
 	
 	// Need to remove velocity from this frame's acceleration.
 	// Removing jitter for resting contacts
-	velocityFromAcc = blocks[0]->acceleration.dot(-1.0f * scaledNormal) * timeIn;
-	velocityFromAcc += blocks[0]->angAcceleration.cross(relPos[0])[2] * timeIn;
+	velocityFromAcc = blocks[0]->Acceleration().dot(-1.0f * scaledNormal) * timeIn;
+	velocityFromAcc += blocks[0]->AngAcceleration().cross(relPos[0])[2] * timeIn;
 
-	velocityFromAcc -= blocks[1]->acceleration.dot(-1.0f * scaledNormal) * timeIn;
-	velocityFromAcc -= blocks[1]->angAcceleration.cross(relPos[1])[2] * timeIn;
+	velocityFromAcc -= blocks[1]->Acceleration().dot(-1.0f * scaledNormal) * timeIn;
+	velocityFromAcc -= blocks[1]->AngAcceleration().cross(relPos[1])[2] * timeIn;
 
 	// No restitution if velocity below our minimum limit
     if (abs(contactVelocity[2]) < velocityLimit)
@@ -81,27 +118,27 @@ void PhysicsContact::ChangeVelocity()
 	// Need to calculate the impulse now
 	// We are assuming no friction here
 	Vect deltaVelWorld = (relPos[0]).cross(normal);
-	deltaVelWorld *= blocks[0]->inverseInertiaTensorWorld;
+	deltaVelWorld *= blocks[0]->InverseInertiaTensorWorld();
 	deltaVelWorld = Vect(deltaVelWorld).cross( relPos[0] );
 
 	// Now get change in contact coordinates in direction of normal
 	float deltaVelocity = deltaVelWorld.dot(normal);
 
 	// Add linear component
-	deltaVelocity += blocks[0]->inverseMass;
+	deltaVelocity += blocks[0]->InverseMass();
 
 	// Now do same for second body
-	if (blocks[1] != 0 && blocks[1]->inverseMass != 0.0f)
+	if (blocks[1] != 0 && blocks[1]->InverseMass() != 0.0f)
 	{
 		deltaVelWorld = (relPos[1]).cross(normal);
-		deltaVelWorld *= blocks[1]->inverseInertiaTensorWorld;
+		deltaVelWorld *= blocks[1]->InverseInertiaTensorWorld();
 		deltaVelWorld = Vect(deltaVelWorld).cross( relPos[1] );
 
 		// Add change due to rotation
 		deltaVelocity +=  deltaVelWorld.dot(normal) ;
 
 		// Add change due to linear motion
-		deltaVelocity += blocks[1]->inverseMass;
+		deltaVelocity += blocks[1]->InverseMass();
 	}
 
 	// Return if no change needed
@@ -115,25 +152,25 @@ void PhysicsContact::ChangeVelocity()
 	
     // Now split impulse into its linear and rotational components
     Vect impulsiveTorque = relPos[0].cross(impulse);
-    angVelocityChange[0] = impulsiveTorque * blocks[0]->inverseInertiaTensorWorld;
+    angVelocityChange[0] = impulsiveTorque * blocks[0]->InverseInertiaTensorWorld();
     velocityChange[0].set(0.0f, 0.0f, 0.0f);
-    velocityChange[0] += impulse * blocks[0]->inverseMass;
+    velocityChange[0] += impulse * blocks[0]->InverseMass();
     
     // Apply changes to velocity and angular velocity
-    blocks[0]->velocity += velocityChange[0];
-	blocks[0]->angVelocity += angVelocityChange[0];
+    blocks[0]->Velocity() += velocityChange[0];
+	blocks[0]->AngVelocity() += angVelocityChange[0];
 
     // Now do same for body 1, if exists
-    if (blocks[1] != 0 && blocks[1]->inverseMass != 0.0f)
+    if (blocks[1] != 0 && blocks[1]->InverseMass() != 0.0f)
     {
         Vect impulsiveTorque = (impulse).cross(relPos[1]);
-        angVelocityChange[1] = impulsiveTorque * blocks[1]->inverseInertiaTensorWorld;
+        angVelocityChange[1] = impulsiveTorque * blocks[1]->InverseInertiaTensorWorld();
         velocityChange[1].set(0.0f, 0.0f, 0.0f);
-		velocityChange[1] += impulse * -blocks[1]->inverseMass;
+		velocityChange[1] += impulse * -blocks[1]->InverseMass();
 
         // Apply changes to velocity and angular velocity
-		blocks[1]->velocity += velocityChange[1];
-		blocks[1]->angVelocity += angVelocityChange[1];
+		blocks[1]->Velocity() += velocityChange[1];
+		blocks[1]->AngVelocity() += angVelocityChange[1];
     }
 };
 
@@ -143,7 +180,7 @@ void PhysicsContact::ChangePosition()
     if (penetration <= 0.0f) return;
 
     // Get total inverse mass
-	float totalInvMass = blocks[0]->inverseMass + blocks[1]->inverseMass;
+	float totalInvMass = blocks[0]->InverseMass() + blocks[1]->InverseMass();
 
     // Do nothing if all particles have infinite mass
     if (totalInvMass <= 0.0f) return;
@@ -153,15 +190,15 @@ void PhysicsContact::ChangePosition()
 
     // Find movement for each body
     Vect bodyMovement[2];
-    bodyMovement[0] = movePerInvMass * blocks[0]->inverseMass;
-    bodyMovement[1] = movePerInvMass * -1.0f * blocks[1]->inverseMass;
+    bodyMovement[0] = movePerInvMass * blocks[0]->InverseMass();
+    bodyMovement[1] = movePerInvMass * -1.0f * blocks[1]->InverseMass();
 
     // Update positions
     Vect positions[2];
-	positions[0] = blocks[0]->position;
-	positions[1] = blocks[1]->position;
-    blocks[0]->position = (positions[0] + bodyMovement[0]);
-    blocks[1]->position = (positions[1] + bodyMovement[1]);
+	positions[0] = blocks[0]->Position();
+	positions[1] = blocks[1]->Position();
+    blocks[0]->Position() = (positions[0] + bodyMovement[0]);
+    blocks[1]->Position() = (positions[1] + bodyMovement[1]);
 };
 
 // Calculate local orthonormal basis,
@@ -215,7 +252,7 @@ void PhysicsContact::CalculateData(const float timeIn)
 
     // Simple check to see if only bodies[1] exists
     // Switch it to bodies[0] if so
-    if (blocks[0] == 0 || blocks[0]->inverseMass == 0.0f)
+    if (blocks[0] == 0 || blocks[0]->InverseMass() == 0.0f)
     {
         this->normal *= -1.0f;
         Block* tmp = blocks[1];
@@ -227,10 +264,10 @@ void PhysicsContact::CalculateData(const float timeIn)
     this->CalculateBasis();
 
     // Calculate relative positions (of collision point with respect to each body)
-	relPos[0] = this->contactPoint - blocks[0]->position;
+	relPos[0] = this->contactPoint - blocks[0]->Position();
     if (blocks[1] != 0)
     {
-        relPos[1] = this->contactPoint - blocks[1]->position;
+        relPos[1] = this->contactPoint - blocks[1]->Position();
     }
 
     // Now calculate relative velocity of the 2 bodies, at the contact point
@@ -254,8 +291,8 @@ Vect PhysicsContact::CalculateLocalVelocity(const int blockIndex, const float ti
     Block* body = blocks[blockIndex];
 
     // Calculate the velocity at contact point
-    Vect velocity = body->angVelocity.cross(relPos[blockIndex]);
-    velocity += body->velocity;
+    Vect velocity = body->AngVelocity().cross(relPos[blockIndex]);
+    velocity += body->Velocity();
 
     // Convert to contact coordinates
     velocity *= this->worldToContact;
@@ -6,6 +6,31 @@
 
 class Block;
 
+// Most points a contact manifold keeps
+static const int MAX_CONTACT_POINTS = 4;
+
+// Where two blocks touch - one normal, and up to 4 points spread over the touching area
+// A face resting on a face needs points at its corners to sit still, a single point makes it rock
+struct ContactManifold
+{
+	// Clear the contact
+	void Reset();
+
+	// Contact normal, pointing from blocks[1] towards blocks[0]
+	Vect				normal;
+
+	// Contact points (world space) and how deep each one is, deepest first
+	Vect				points[MAX_CONTACT_POINTS];
+	float				penetrations[MAX_CONTACT_POINTS];
+	int					numPoints;
+
+	// Amount the blocks are penetrating along the normal
+	float				penetration;
+
+	// Pointers to blocks involved in collision
+	Block*				blocks[2];
+};
+
 // Class representing a collision
 // Has knowledge to adjust the object's positions and velocities
 class PhysicsContact
@@ -15,6 +40,9 @@ public:
     PhysicsContact();
     ~PhysicsContact();
 
+	// Resolve a whole manifold - an impulse at each point, then one position change for the pair
+	void ResolveManifold(const ContactManifold& manifoldIn, const float timeIn);
+
 	void CalculateDesiredVelocityChange(const float timeIn);
     void ChangePosition();
     void ChangeVelocity();
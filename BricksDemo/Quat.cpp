@@ -2,53 +2,6 @@
 #include <assert.h>
 #include "Quat.h"
 
-//Default constructor
-Quat::Quat()
-	: qx(0.0f), qy(0.0f), qz(0.0f), qw(1.0f)
-{
-};
-
-// Copy constructor
-Quat::Quat(const Quat& quatIn)
-	: qVect(quatIn.qVect)
-{
-};
-
-// Specialized constructor
-Quat::Quat(const float qxIn, const float qyIn, const float qzIn, const float qwIn)
-	: qVect( Vect(qxIn, qyIn, qzIn, qwIn) )
-{
-};
-
-// Assignment operator
-Quat& Quat::operator= (const Quat& rhs)
-{
-    if (this != &rhs)
-	{
-        this->qx = rhs.qx;
-        this->qy = rhs.qy;
-        this->qz = rhs.qz;
-        this->qw = rhs.qw;
-	}
-
-    return *this;
-};
-
-// Set function for 4 floats
-void Quat::set(const float qxIn, const float qyIn, const float qzIn, const float qwIn)
-{
-    this->qx = qxIn;
-    this->qy = qyIn;
-    this->qz = qzIn;
-    this->qw = qwIn;
-};
-
-// Set function for another quat
-void Quat::set(const Quat& quatIn)
-{
-    this->qVect = quatIn.qVect;
-};
-
 // Set function for angles of rotation around X, Y, and Z axes
 void Quat::setRotXYZ(const float rotxIn, const float rotyIn, const float rotzIn)
 {
@@ -70,26 +23,41 @@ void Quat::setAxisAngle(const Vect& axisIn, const float angleIn)
 	this->qw = cosf(angleIn * 0.5f);
 }
 
-// Multiplication by another quat - used to combine rotations
-Quat Quat::operator*(const Quat& quatIn) const
+// Advance by a world space angular velocity over a time step
+// Rotating by angle |w|t around w is exp(w t / 2), applied after our current rotation
+void Quat::integrate(const Vect& angVelocityIn, const float timeIn)
 {
-    Quat returnQuat;
-    returnQuat.qVect = quatIn.qVect.cross(this->qVect) + quatIn.qw * this->qVect + this->qw * quatIn.qVect;
-    returnQuat.qw = this->qw * quatIn.qw - this->qVect.dot(quatIn.qVect);
+	const Vect halfAngle = angVelocityIn * (0.5f * timeIn);
+	const float thetaSqr = halfAngle.magSqr();
 
-    return returnQuat;
-};
+	// sin(theta) / theta and cos(theta) for the half angle
+	float sinOverTheta;
+	float cosine;
+	if (thetaSqr < QUAT_SMALL_ANGLE_SQR * 0.25f)
+	{
+		// Small steps (nearly all of them) - Taylor series, good to float precision here and no trig
+		sinOverTheta = 1.0f - thetaSqr * (1.0f / 6.0f) * (1.0f - thetaSqr * 0.05f);
+		cosine = 1.0f - thetaSqr * 0.5f * (1.0f - thetaSqr * (1.0f / 12.0f));
+	}
+	else
+	{
+		const float theta = sqrtf(thetaSqr);
+		sinOverTheta = sinf(theta) / theta;
+		cosine = cosf(theta);
+	}
 
-// Constant indexing
-const float Quat::operator[](const int indexIn) const
-{
-	assert(indexIn >= 0 && indexIn <= 3);
-    return this->q[indexIn];
-}
+	// Same product as *this * Quat(axisPart, cosine), without building the step quat in memory
+	const Vect axisPart = halfAngle * sinOverTheta;
+	const Vect newVect = axisPart.cross(this->qVect) + cosine * this->qVect + this->qw * axisPart;
+	const float newW = this->qw * cosine - this->qVect.dot(axisPart);
 
-// Indexing for modification
-float& Quat::operator[](const int indexIn)
-{
-	assert(indexIn >= 0 && indexIn <= 3);
-    return this->q[indexIn];
-}
+	this->qVect = newVect;
+	this->qw = newW;
+
+	// Each multiply can nudge the length by a rounding error - pull it back once that adds up
+	const float lengthSqr = this->magSqr();
+	if (fabsf(lengthSqr - 1.0f) > QUAT_DRIFT_TOLERANCE)
+	{
+		this->norm();
+	}
+};
@@ -4,19 +4,33 @@
 #include "Matrix.h"
 #include "Vect.h"
 
+// Angle (squared, in radians) below which integrate() uses its series instead of sin and cos
+#define QUAT_SMALL_ANGLE_SQR 0.01f
+
+// How far the length squared can drift from 1 before integrate() renormalizes
+#define QUAT_DRIFT_TOLERANCE 0.00001f
+
 class Quat 
 {
 public:
-    // Constructors
-    Quat();
-    Quat(const Quat& quatIn);
-    Quat(const float qxIn, const float qyIn, const float qzIn, const float qwIn); 
+	friend class RigidTransform;
+
+    // Constructors (copy, assignment and destructor are the compiler's trivial ones)
+    MATH_CONSTEXPR Quat()
+	: qVect(0.0f, 0.0f, 0.0f, 1.0f)
+    {
+    }
 
-    // Assignment operator
-    Quat& operator= (const Quat& rhs);
+    MATH_CONSTEXPR Quat(const float qxIn, const float qyIn, const float qzIn, const float qwIn)
+	: qVect(qxIn, qyIn, qzIn, qwIn)
+    {
+    }
 
-    // Destructor
-	~Quat() { }
+    // No rotation
+    static MATH_CONSTEXPR Quat identity()
+    {
+        return Quat(0.0f, 0.0f, 0.0f, 1.0f);
+    }
 
     // Set functions
     void set(const float qxIn, const float qyIn, const float qzIn, const float qwIn); 
@@ -33,6 +47,23 @@ public:
     // Overloading multiplication
     Quat operator* (const Quat& quatIn) const;
 
+    // Conjugate (the inverse rotation for a unit quat)
+    Quat getConj() const;
+
+    // Length squared, and scaling back to unit length
+    float magSqr() const;
+    void norm();
+
+    // Advance by a world space angular velocity over a time step (exponential map)
+    // Renormalizes whenever the length has drifted, so long runs stay a pure rotation
+    void integrate(const Vect& angVelocityIn, const float timeIn);
+
+    // Rotate a vector, same result as multiplying it by the rotation matrix from set(Quat)
+    Vect rotate(const Vect& vectIn) const;
+
+    // Rotate a vector by the inverse rotation (unit quats only), without forming the conjugate
+    Vect rotateInv(const Vect& vectIn) const;
+
 private:
 
 	// Different ways to look at the data
@@ -51,15 +82,83 @@ private:
 			float q[4];
 		};
 
-        struct
-		{
-            Vect qVect;
-		};
+        Vect qVect;
 	};
 
 
 };
 
+// Set function for 4 floats
+inline void Quat::set(const float qxIn, const float qyIn, const float qzIn, const float qwIn)
+{
+    this->qx = qxIn;
+    this->qy = qyIn;
+    this->qz = qzIn;
+    this->qw = qwIn;
+};
+
+// Set function for another quat
+inline void Quat::set(const Quat& quatIn)
+{
+    this->qVect = quatIn.qVect;
+};
+
+// Multiplication by another quat - used to combine rotations
+inline Quat Quat::operator*(const Quat& quatIn) const
+{
+    Quat returnQuat;
+    returnQuat.qVect = quatIn.qVect.cross(this->qVect) + quatIn.qw * this->qVect + this->qw * quatIn.qVect;
+    returnQuat.qw = this->qw * quatIn.qw - this->qVect.dot(quatIn.qVect);
+
+    return returnQuat;
+};
+
+// Conjugate (the inverse rotation for a unit quat)
+inline Quat Quat::getConj() const
+{
+    return Quat(-this->qx, -this->qy, -this->qz, this->qw);
+};
+
+// Length squared of all 4 components
+inline float Quat::magSqr() const
+{
+    return this->qx * this->qx + this->qy * this->qy + this->qz * this->qz + this->qw * this->qw;
+};
+
+// Scale back to unit length (modifies this quat)
+inline void Quat::norm()
+{
+    const float f = 1.0f / sqrtf(this->magSqr());
+    this->set(this->qx * f, this->qy * f, this->qz * f, this->qw * f);
+};
+
+// Rotate a vector - v + 2w(q x v) + 2q x (q x v), without building a matrix
+inline Vect Quat::rotate(const Vect& vectIn) const
+{
+    const Vect t = 2.0f * this->qVect.cross(vectIn);
+    return vectIn + this->qw * t + this->qVect.cross(t);
+};
+
+// Rotate a vector by the inverse rotation - same as getConj().rotate(), with the signs folded in
+inline Vect Quat::rotateInv(const Vect& vectIn) const
+{
+    const Vect t = 2.0f * this->qVect.cross(vectIn);
+    return vectIn - this->qw * t + this->qVect.cross(t);
+};
+
+// Constant indexing
+inline const float Quat::operator[](const int indexIn) const
+{
+	assert(indexIn >= 0 && indexIn <= 3);
+    return this->q[indexIn];
+}
+
+// Indexing for modification
+inline float& Quat::operator[](const int indexIn)
+{
+	assert(indexIn >= 0 && indexIn <= 3);
+    return this->q[indexIn];
+}
 
 
 #endif // #ifndef QUAT_H
@@ -0,0 +1,249 @@
+#include <math.h>
+#include "QuatBatch.h"
+#include "BatchFloat.h"
+
+#if MATH_SIMD
+
+// Write the rotation matrices of 4 bodies, given each element with one body per lane
+// The elements are m0, m1, m2, m4, m5, m6, m8, m9, m10 (passed as an array, 32-bit MSVC can't take that many by value)
+static inline void batchStoreMatrices(Matrix* matricesOut, const __m128 elementsIn[9])
+{
+	// Transposing (m0, m1, m2, 0) gives row 0 of each body, and so on
+	__m128 m0 = elementsIn[0];
+	__m128 m1 = elementsIn[1];
+	__m128 m2 = elementsIn[2];
+	__m128 m4 = elementsIn[3];
+	__m128 m5 = elementsIn[4];
+	__m128 m6 = elementsIn[5];
+	__m128 m8 = elementsIn[6];
+	__m128 m9 = elementsIn[7];
+	__m128 m10 = elementsIn[8];
+	__m128 m3 = _mm_setzero_ps();
+	__m128 m7 = _mm_setzero_ps();
+	__m128 m11 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+	_MM_TRANSPOSE4_PS(m4, m5, m6, m7);
+	_MM_TRANSPOSE4_PS(m8, m9, m10, m11);
+
+	const __m128 row3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+	const __m128 rows0[4] = { m0, m1, m2, m3 };
+	const __m128 rows1[4] = { m4, m5, m6, m7 };
+	const __m128 rows2[4] = { m8, m9, m10, m11 };
+
+	for (int k = 0; k < 4; k++)
+	{
+		float* matrix = &matricesOut[k]._m[0];
+		_mm_storeu_ps(matrix, rows0[k]);
+		_mm_storeu_ps(matrix + 4, rows1[k]);
+		_mm_storeu_ps(matrix + 8, rows2[k]);
+		_mm_storeu_ps(matrix + 12, row3);
+	}
+};
+
+#endif
+
+// Default constructor
+QuatBatch::QuatBatch()
+	:	x(),
+		y(),
+		z(),
+		w()
+{
+};
+
+// Number of quats
+void QuatBatch::resize(const int countIn)
+{
+	this->x.resize(countIn, 0.0f);
+	this->y.resize(countIn, 0.0f);
+	this->z.resize(countIn, 0.0f);
+	this->w.resize(countIn, 1.0f);
+};
+
+// Number of quats
+int QuatBatch::count() const
+{
+	return (int)this->x.size();
+};
+
+// Copy a quat in
+void QuatBatch::set(const int indexIn, const Quat& quatIn)
+{
+	this->x[indexIn] = quatIn[0];
+	this->y[indexIn] = quatIn[1];
+	this->z[indexIn] = quatIn[2];
+	this->w[indexIn] = quatIn[3];
+};
+
+// Copy a quat out
+Quat QuatBatch::get(const int indexIn) const
+{
+	return Quat(this->x[indexIn], this->y[indexIn], this->z[indexIn], this->w[indexIn]);
+};
+
+// Matrix::set(Quat) for every quat
+void QuatBatch::getMatrices(Matrix* matricesOut) const
+{
+	const int numQuats = this->count();
+	int i = 0;
+
+#if MATH_SIMD
+	const BatchFloat one = batchSet(1.0f);
+	const BatchFloat two = batchSet(2.0f);
+
+	for (; i + MATH_BATCH_WIDTH <= numQuats; i += MATH_BATCH_WIDTH)
+	{
+		const BatchFloat qx = batchLoad(&this->x[i]);
+		const BatchFloat qy = batchLoad(&this->y[i]);
+		const BatchFloat qz = batchLoad(&this->z[i]);
+		const BatchFloat qw = batchLoad(&this->w[i]);
+
+		// Same expressions as Matrix::set(Quat), one body per lane
+		const BatchFloat m0 = batchSub(one, batchMul(two, batchAdd(batchMul(qy, qy), batchMul(qz, qz))));
+		const BatchFloat m1 = batchMul(two, batchAdd(batchMul(qx, qy), batchMul(qw, qz)));
+		const BatchFloat m2 = batchMul(two, batchSub(batchMul(qx, qz), batchMul(qw, qy)));
+
+		const BatchFloat m4 = batchMul(two, batchSub(batchMul(qx, qy), batchMul(qw, qz)));
+		const BatchFloat m5 = batchSub(one, batchMul(two, batchAdd(batchMul(qx, qx), batchMul(qz, qz))));
+		const BatchFloat m6 = batchMul(two, batchAdd(batchMul(qy, qz), batchMul(qw, qx)));
+
+		const BatchFloat m8 = batchMul(two, batchAdd(batchMul(qx, qz), batchMul(qw, qy)));
+		const BatchFloat m9 = batchMul(two, batchSub(batchMul(qy, qz), batchMul(qw, qx)));
+		const BatchFloat m10 = batchSub(one, batchMul(two, batchAdd(batchMul(qx, qx), batchMul(qy, qy))));
+
+		for (int h = 0; h < MATH_BATCH_WIDTH / 4; h++)
+		{
+			const __m128 elements[9] =
+			{
+				batchQuarter(m0, h), batchQuarter(m1, h), batchQuarter(m2, h),
+				batchQuarter(m4, h), batchQuarter(m5, h), batchQuarter(m6, h),
+				batchQuarter(m8, h), batchQuarter(m9, h), batchQuarter(m10, h)
+			};
+			batchStoreMatrices(matricesOut + i + 4 * h, elements);
+		}
+	}
+#endif
+
+	// Leftovers
+	for (; i < numQuats; i++)
+	{
+		matricesOut[i].set(this->get(i));
+	}
+};
+
+// Quat::integrate for every quat
+void QuatBatch::integrate(const float* angXIn, const float* angYIn, const float* angZIn, const float timeIn,
+	const float* maskIn /*= 0*/)
+{
+	const int numQuats = this->count();
+	int i = 0;
+
+#if MATH_SIMD
+	const BatchFloat one = batchSet(1.0f);
+	const BatchFloat halfTime = batchSet(0.5f * timeIn);
+	const BatchFloat smallAngle = batchSet(QUAT_SMALL_ANGLE_SQR * 0.25f);
+	const BatchFloat zero = batchSet(0.0f);
+
+	for (; i + MATH_BATCH_WIDTH <= numQuats; i += MATH_BATCH_WIDTH)
+	{
+		const BatchFloat hx = batchMul(batchLoad(angXIn + i), halfTime);
+		const BatchFloat hy = batchMul(batchLoad(angYIn + i), halfTime);
+		const BatchFloat hz = batchMul(batchLoad(angZIn + i), halfTime);
+		const BatchFloat thetaSqr = batchAdd(batchAdd(batchMul(hx, hx), batchMul(hy, hy)), batchMul(hz, hz));
+
+		// Any body turning too far for the series this step takes the sin and cos path, one at a time
+		if (!batchAllSet(batchLess(thetaSqr, smallAngle)))
+		{
+			for (int k = i; k < i + MATH_BATCH_WIDTH; k++)
+			{
+				if (maskIn && maskIn[k] == 0.0f) continue;
+
+				Quat quat = this->get(k);
+				quat.integrate(Vect(angXIn[k], angYIn[k], angZIn[k]), timeIn);
+				this->set(k, quat);
+			}
+			continue;
+		}
+
+		// sin(theta) / theta and cos(theta) for the half angle, from the same series as Quat::integrate
+		const BatchFloat sinOverTheta = batchSub(one, batchMul(batchMul(thetaSqr, batchSet(1.0f / 6.0f)),
+			batchSub(one, batchMul(thetaSqr, batchSet(0.05f)))));
+		const BatchFloat cosine = batchSub(one, batchMul(batchMul(thetaSqr, batchSet(0.5f)),
+			batchSub(one, batchMul(thetaSqr, batchSet(1.0f / 12.0f)))));
+
+		const BatchFloat ax = batchMul(hx, sinOverTheta);
+		const BatchFloat ay = batchMul(hy, sinOverTheta);
+		const BatchFloat az = batchMul(hz, sinOverTheta);
+
+		const BatchFloat qx = batchLoad(&this->x[i]);
+		const BatchFloat qy = batchLoad(&this->y[i]);
+		const BatchFloat qz = batchLoad(&this->z[i]);
+		const BatchFloat qw = batchLoad(&this->w[i]);
+
+		// axisPart x q + cosine * q + qw * axisPart, and qw * cosine - q . axisPart
+		const BatchFloat nx = batchAdd(batchAdd(batchSub(batchMul(ay, qz), batchMul(az, qy)), batchMul(cosine, qx)), batchMul(qw, ax));
+		const BatchFloat ny = batchAdd(batchAdd(batchSub(batchMul(az, qx), batchMul(ax, qz)), batchMul(cosine, qy)), batchMul(qw, ay));
+		const BatchFloat nz = batchAdd(batchAdd(batchSub(batchMul(ax, qy), batchMul(ay, qx)), batchMul(cosine, qz)), batchMul(qw, az));
+		const BatchFloat nw = batchSub(batchMul(qw, cosine),
+			batchAdd(batchAdd(batchMul(qx, ax), batchMul(qy, ay)), batchMul(qz, az)));
+
+		// Renormalize just the lanes that have drifted
+		const BatchFloat lengthSqr = batchAdd(batchAdd(batchAdd(batchMul(nx, nx), batchMul(ny, ny)), batchMul(nz, nz)), batchMul(nw, nw));
+		const BatchFloat drifted = batchGreater(batchAbs(batchSub(lengthSqr, one)), batchSet(QUAT_DRIFT_TOLERANCE));
+		const BatchFloat f = batchDiv(one, batchSqrt(lengthSqr));
+
+		// Masked off lanes keep the quat they came in with
+		const BatchFloat moving = maskIn ? batchGreater(batchAbs(batchLoad(maskIn + i)), zero) : batchLess(zero, one);
+
+		batchStore(&this->x[i], batchSelect(moving, batchSelect(drifted, batchMul(nx, f), nx), qx));
+		batchStore(&this->y[i], batchSelect(moving, batchSelect(drifted, batchMul(ny, f), ny), qy));
+		batchStore(&this->z[i], batchSelect(moving, batchSelect(drifted, batchMul(nz, f), nz), qz));
+		batchStore(&this->w[i], batchSelect(moving, batchSelect(drifted, batchMul(nw, f), nw), qw));
+	}
+#endif
+
+	// Leftovers
+	for (; i < numQuats; i++)
+	{
+		if (maskIn && maskIn[i] == 0.0f) continue;
+
+		Quat quat = this->get(i);
+		quat.integrate(Vect(angXIn[i], angYIn[i], angZIn[i]), timeIn);
+		this->set(i, quat);
+	}
+};
+
+// Quat::norm for every quat
+void QuatBatch::norm()
+{
+	const int numQuats = this->count();
+	int i = 0;
+
+#if MATH_SIMD
+	const BatchFloat one = batchSet(1.0f);
+
+	for (; i + MATH_BATCH_WIDTH <= numQuats; i += MATH_BATCH_WIDTH)
+	{
+		const BatchFloat qx = batchLoad(&this->x[i]);
+		const BatchFloat qy = batchLoad(&this->y[i]);
+		const BatchFloat qz = batchLoad(&this->z[i]);
+		const BatchFloat qw = batchLoad(&this->w[i]);
+
+		const BatchFloat lengthSqr = batchAdd(batchAdd(batchAdd(batchMul(qx, qx), batchMul(qy, qy)), batchMul(qz, qz)), batchMul(qw, qw));
+		const BatchFloat f = batchDiv(one, batchSqrt(lengthSqr));
+
+		batchStore(&this->x[i], batchMul(qx, f));
+		batchStore(&this->y[i], batchMul(qy, f));
+		batchStore(&this->z[i], batchMul(qz, f));
+		batchStore(&this->w[i], batchMul(qw, f));
+	}
+#endif
+
+	// Leftovers
+	for (; i < numQuats; i++)
+	{
+		Quat quat = this->get(i);
+		quat.norm();
+		this->set(i, quat);
+	}
+};
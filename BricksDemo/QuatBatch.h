@@ -0,0 +1,42 @@
+#ifndef QUAT_BATCH_H
+#define QUAT_BATCH_H
+
+#include <vector>
+#include "Matrix.h"
+#include "Quat.h"
+
+// A run of quats stored one component per array, so the SIMD lanes go across bodies
+// (8 at a time with AVX, 4 with SSE) instead of across the x, y, z, and w of one quat.
+// Every kernel gives the same bits as calling the single quat version on each entry.
+class QuatBatch
+{
+public:
+	QuatBatch();
+
+	// Number of quats (resizing keeps the ones that fit, new ones are identity)
+	void resize(const int countIn);
+	int count() const;
+
+	// Copy single quats in and out
+	void set(const int indexIn, const Quat& quatIn);
+	Quat get(const int indexIn) const;
+
+	// Matrix::set(Quat) for every quat - matricesOut needs room for count() matrices
+	void getMatrices(Matrix* matricesOut) const;
+
+	// Quat::integrate for every quat, quat i spinning at (angXIn[i], angYIn[i], angZIn[i])
+	// With maskIn, only quats whose mask is non-zero move - the rest keep their exact bits
+	void integrate(const float* angXIn, const float* angYIn, const float* angZIn, const float timeIn,
+		const float* maskIn = 0);
+
+	// Quat::norm for every quat
+	void norm();
+
+	// Components, each count() long
+	std::vector<float>			x;
+	std::vector<float>			y;
+	std::vector<float>			z;
+	std::vector<float>			w;
+};
+
+#endif
@@ -0,0 +1,168 @@
+#ifndef MATH_RIGID_TRANSFORM_H
+#define MATH_RIGID_TRANSFORM_H
+
+#include "Vect.h"
+#include "Matrix.h"
+#include "Quat.h"
+
+// Rotation followed by a translation, stored as a quat and a vector (32 bytes instead of a 64 byte Matrix)
+// Follows the Matrix conventions: points are row vectors, and A * B applies A first, then B
+class RigidTransform
+{
+public:
+	// Constructors (copy, assignment and destructor are the compiler's trivial ones)
+	MATH_CONSTEXPR RigidTransform()
+		: rotation(), translation(0.0f, 0.0f, 0.0f, 1.0f)
+	{
+	}
+
+	MATH_CONSTEXPR RigidTransform(const Quat& rotationIn, const Vect& translationIn)
+		: rotation(rotationIn), translation(translationIn)
+	{
+	}
+
+	// No rotation or translation
+	static MATH_CONSTEXPR RigidTransform identity()
+	{
+		return RigidTransform();
+	}
+
+	// Set functions
+	void set(const Quat& rotationIn, const Vect& translationIn);
+
+	// Combine transforms - this one is applied first, then transformIn
+	RigidTransform operator* (const RigidTransform& transformIn) const;
+	RigidTransform& operator*= (const RigidTransform& transformIn);
+
+	// Returns inverse transform (this object not modified)
+	RigidTransform getInv() const;
+
+	// Local to world
+	Vect transformPoint(const Vect& pointIn) const;
+	Vect transformDirection(const Vect& directionIn) const;
+
+	// World to local, without building the inverse
+	Vect invTransformPoint(const Vect& pointIn) const;
+	Vect invTransformDirection(const Vect& directionIn) const;
+
+	// World space directions of the local x, y, and z axes (rows 0-2 of getMatrix)
+	void getAxes(Vect& xAxisOut, Vect& yAxisOut, Vect& zAxisOut) const;
+
+	// Full 4x4 matrix, for drawing or anything else that needs one
+	Matrix getMatrix() const;
+
+	Quat				rotation;
+	Vect				translation;
+};
+
+#if MATH_SIMD
+
+// One row of a quat's rotation matrix - 2 * sum off the diagonal, 1 - 2 * sum on it, and w = 0
+static inline __m128 simdAxisRow(const __m128 sum, const __m128 diagMask)
+{
+	const __m128 xyzMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+	const __m128 twice = _mm_mul_ps(_mm_set1_ps(2.0f), sum);
+	const __m128 diag = _mm_sub_ps(_mm_set1_ps(1.0f), twice);
+	return _mm_and_ps(_mm_or_ps(_mm_and_ps(diagMask, diag), _mm_andnot_ps(diagMask, twice)), xyzMask);
+};
+
+#endif
+
+// Set function
+inline void RigidTransform::set(const Quat& rotationIn, const Vect& translationIn)
+{
+	this->rotation = rotationIn;
+	this->translation = translationIn;
+};
+
+// Combine transforms
+inline RigidTransform RigidTransform::operator* (const RigidTransform& transformIn) const
+{
+	return RigidTransform(this->rotation * transformIn.rotation,
+		transformIn.rotation.rotate(this->translation) + transformIn.translation);
+};
+
+// Combine transforms (*=)
+inline RigidTransform& RigidTransform::operator*= (const RigidTransform& transformIn)
+{
+	*this = *this * transformIn;
+	return *this;
+};
+
+// Returns inverse transform (this object not modified)
+inline RigidTransform RigidTransform::getInv() const
+{
+	const Quat inverseRotation = this->rotation.getConj();
+	return RigidTransform(inverseRotation, inverseRotation.rotate(this->translation) * -1.0f);
+};
+
+// Local point to world
+inline Vect RigidTransform::transformPoint(const Vect& pointIn) const
+{
+	return this->rotation.rotate(pointIn) + this->translation;
+};
+
+// Local direction to world (no translation)
+inline Vect RigidTransform::transformDirection(const Vect& directionIn) const
+{
+	return this->rotation.rotate(directionIn);
+};
+
+// World point to local
+inline Vect RigidTransform::invTransformPoint(const Vect& pointIn) const
+{
+	return this->rotation.rotateInv(pointIn - this->translation);
+};
+
+// World direction to local (no translation)
+inline Vect RigidTransform::invTransformDirection(const Vect& directionIn) const
+{
+	return this->rotation.rotateInv(directionIn);
+};
+
+// World space axes - same values as the rows of Matrix::set(Quat)
+inline void RigidTransform::getAxes(Vect& xAxisOut, Vect& yAxisOut, Vect& zAxisOut) const
+{
+#if MATH_SIMD
+	// Each row is 2 * (a * b +/- c * d), with 1 - that on the diagonal, worked out lane by lane
+	// in the same order as the scalar code so both give the same bits
+	const __m128 q = _mm_loadu_ps(this->rotation.q);
+
+	// Row 0: (1 - 2(yy + zz), 2(xy + wz), 2(xz - wy))
+	__m128 sum = _mm_add_ps(_mm_mul_ps(MATH_SHUFFLE(q, 1, 0, 0, 3), MATH_SHUFFLE(q, 1, 1, 2, 3)),
+		_mm_xor_ps(_mm_mul_ps(MATH_SHUFFLE(q, 2, 3, 3, 3), MATH_SHUFFLE(q, 2, 2, 1, 3)), _mm_set_ps(0.0f, -0.0f, 0.0f, 0.0f)));
+	_mm_storeu_ps(&xAxisOut[0], simdAxisRow(sum, _mm_castsi128_ps(_mm_set_epi32(0, 0, 0, -1))));
+
+	// Row 1: (2(xy - wz), 1 - 2(xx + zz), 2(yz + wx))
+	sum = _mm_add_ps(_mm_mul_ps(MATH_SHUFFLE(q, 0, 0, 1, 3), MATH_SHUFFLE(q, 1, 0, 2, 3)),
+		_mm_xor_ps(_mm_mul_ps(MATH_SHUFFLE(q, 3, 2, 3, 3), MATH_SHUFFLE(q, 2, 2, 0, 3)), _mm_set_ps(0.0f, 0.0f, 0.0f, -0.0f)));
+	_mm_storeu_ps(&yAxisOut[0], simdAxisRow(sum, _mm_castsi128_ps(_mm_set_epi32(0, 0, -1, 0))));
+
+	// Row 2: (2(xz + wy), 2(yz - wx), 1 - 2(xx + yy))
+	sum = _mm_add_ps(_mm_mul_ps(MATH_SHUFFLE(q, 0, 1, 0, 3), MATH_SHUFFLE(q, 2, 2, 0, 3)),
+		_mm_xor_ps(_mm_mul_ps(MATH_SHUFFLE(q, 3, 3, 1, 3), MATH_SHUFFLE(q, 1, 0, 1, 3)), _mm_set_ps(0.0f, 0.0f, -0.0f, 0.0f)));
+	_mm_storeu_ps(&zAxisOut[0], simdAxisRow(sum, _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, 0))));
+#else
+	const float qx = this->rotation[0];
+	const float qy = this->rotation[1];
+	const float qz = this->rotation[2];
+	const float qw = this->rotation[3];
+
+	xAxisOut.set(1 - 2 * (qy*qy + qz*qz), 2 * (qx*qy + qw*qz), 2 * (qx*qz - qw*qy), 0.0f);
+	yAxisOut.set(2 * (qx*qy - qw*qz), 1 - 2 * (qx*qx + qz*qz), 2 * (qy*qz + qw*qx), 0.0f);
+	zAxisOut.set(2 * (qx*qz + qw*qy), 2 * (qy*qz - qw*qx), 1 - 2 * (qx*qx + qy*qy), 0.0f);
+#endif
+};
+
+// Full 4x4 matrix
+inline Matrix RigidTransform::getMatrix() const
+{
+	Matrix returnMatrix;
+	this->getAxes(returnMatrix.v[0], returnMatrix.v[1], returnMatrix.v[2]);
+	returnMatrix.v[3] = this->translation;
+	returnMatrix.v[3][3] = 1.0f;
+
+	return returnMatrix;
+};
+
+#endif
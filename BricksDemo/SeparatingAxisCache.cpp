@@ -0,0 +1,85 @@
+#include <assert.h>
+#include "SeparatingAxisCache.h"
+
+// Constructor
+SeparatingAxisCache::SeparatingAxisCache()
+	:	previous(),
+		current(),
+		previousMask(0),
+		currentMask(0),
+		numCurrent(0),
+		maxCurrent(0)
+{
+};
+
+// Destructor
+SeparatingAxisCache::~SeparatingAxisCache()
+{
+};
+
+// Forget every pair
+void SeparatingAxisCache::Reset()
+{
+	previous.clear();
+	current.clear();
+	previousMask = 0;
+	currentMask = 0;
+	numCurrent = 0;
+	maxCurrent = 0;
+};
+
+// Start a step
+void SeparatingAxisCache::BeginStep(const int maxPairsIn)
+{
+	// This step's table becomes last step's
+	previous.swap(current);
+	previousMask = currentMask;
+
+	// Table with at least twice as many slots as pairs (power of two so we can mask)
+	unsigned int numSlots = 16;
+	while (numSlots < 2u * (unsigned int)maxPairsIn) numSlots <<= 1;
+
+	const Entry empty = { -1, -1, SAT_NO_AXIS };
+	current.assign(numSlots, empty);
+	currentMask = numSlots - 1;
+	numCurrent = 0;
+	maxCurrent = maxPairsIn;
+};
+
+// Last step's axis for a pair
+unsigned int SeparatingAxisCache::Get(const int oneIn, const int twoIn) const
+{
+	if (previous.empty()) return SAT_NO_AXIS;
+
+	return previous[privFind(previous, previousMask, oneIn, twoIn)].axis;
+};
+
+// This step's axis for a pair
+void SeparatingAxisCache::Set(const int oneIn, const int twoIn, const unsigned int axisIn)
+{
+	assert(!current.empty());
+
+	Entry& entry = current[privFind(current, currentMask, oneIn, twoIn)];
+	if (entry.one < 0)
+	{
+		// Never more pairs than BeginStep was told, so the table stays at most half full
+		assert(numCurrent < maxCurrent);
+		numCurrent++;
+		entry.one = oneIn;
+		entry.two = twoIn;
+	}
+	entry.axis = axisIn;
+};
+
+// Slot of a pair in a table, probing linearly from its hash
+unsigned int SeparatingAxisCache::privFind(const std::vector<Entry>& tableIn, const unsigned int maskIn, const int oneIn, const int twoIn)
+{
+	// Large primes spread neighbouring pairs across the table
+	unsigned int slot = (((unsigned int)oneIn * 73856093u) ^ ((unsigned int)twoIn * 19349663u)) & maskIn;
+
+	while (tableIn[slot].one >= 0 && (tableIn[slot].one != oneIn || tableIn[slot].two != twoIn))
+	{
+		slot = (slot + 1) & maskIn;
+	}
+	return slot;
+};
@@ -0,0 +1,51 @@
+#ifndef SEPARATING_AXIS_CACHE_H
+#define SEPARATING_AXIS_CACHE_H
+
+#include <vector>
+
+// No separating axis known (CheckColliding numbers the axes 0-14)
+static const unsigned int SAT_NO_AXIS = 0xFFFFFF;
+
+// Remembers, for each pair of bricks, the axis that separated them last step or the one they touched on.
+// Pairs that stay apart usually do so along the same axis, so the world (with its axis cache on) retries a face
+// axis before anything else and drops the pair if it still separates them.
+// Two hash tables, last step's and this step's, so pairs the broadphase stops reporting just fall out.
+class SeparatingAxisCache
+{
+public:
+	SeparatingAxisCache();
+	~SeparatingAxisCache();
+
+	// Forget every pair (call when the blocks are replaced)
+	void Reset();
+
+	// Start a step that will store up to this many pairs - what was stored last step can be read during it
+	void BeginStep(const int maxPairsIn);
+
+	// Last step's axis for a pair (SAT_NO_AXIS if it wasn't checked)
+	unsigned int Get(const int oneIn, const int twoIn) const;
+
+	// This step's axis for a pair
+	void Set(const int oneIn, const int twoIn, const unsigned int axisIn);
+
+private:
+	// One pair's axis (one is -1 in empty slots)
+	struct Entry
+	{
+		int				one;
+		int				two;
+		unsigned int	axis;
+	};
+
+	// Slot of a pair in a table - its entry, or the empty slot it would go in
+	static unsigned int privFind(const std::vector<Entry>& tableIn, const unsigned int maskIn, const int oneIn, const int twoIn);
+
+	std::vector<Entry>			previous;
+	std::vector<Entry>			current;
+	unsigned int				previousMask;
+	unsigned int				currentMask;
+	int							numCurrent;
+	int							maxCurrent;
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "SpatialHashGrid.h"
+#include <math.h>
+#include <algorithm>
+
+// Constructor
+SpatialHashGrid::SpatialHashGrid()
+	:	bounds(), entries(), sortedEntries(), entryBuckets(), bucketStart(), pairs(),
+		cellSize(1.0f), invCellSize(1.0f), bucketMask(0), numBlocks(-1)
+{
+};
+
+// Destructor
+SpatialHashGrid::~SpatialHashGrid()
+{
+};
+
+// Recompute the cell size next update (call when the blocks are replaced)
+void SpatialHashGrid::Reset()
+{
+	numBlocks = -1;
+};
+
+// Which cell a coordinate falls into
+int SpatialHashGrid::privCellCoord(const float valueIn) const
+{
+	return (int)floorf(valueIn * invCellSize);
+};
+
+// Which hash bucket a cell lands in
+unsigned int SpatialHashGrid::privHash(const int xIn, const int yIn, const int zIn) const
+{
+	// Large primes spread neighbouring cells across the table
+	const unsigned int h = ((unsigned int)xIn * 73856093u) ^ ((unsigned int)yIn * 19349663u) ^ ((unsigned int)zIn * 83492791u);
+	return h & bucketMask;
+};
+
+// Bin all active blocks and find pairs whose bounds overlap
+void SpatialHashGrid::Update(const BlockPool& blocksIn)
+{
+	const BodyStore& store = blocksIn.Store();
+	pairs.clear();
+
+	// Cells as big as the biggest brick
+	if (numBlocks != blocksIn.Count())
+	{
+		numBlocks = blocksIn.Count();
+		cellSize = 1.0f;
+		for (int i = 0; i < numBlocks; i++)
+		{
+			const Vect& scale = store.scale[i];
+			cellSize = std::max(cellSize, std::max(scale[0], std::max(scale[1], scale[2])));
+		}
+		invCellSize = 1.0f / cellSize;
+		bounds.resize(numBlocks);
+	}
+
+	// One entry for every cell each block touches
+	entries.clear();
+	for (int i = 0; i < numBlocks; i++)
+	{
+		if (!store.flags[i].active) continue;
+
+		AABB& box = bounds[i];
+		CalcBodyAABB(store, i, box);
+
+		const int minX = privCellCoord(box.min[0]), maxX = privCellCoord(box.max[0]);
+		const int minY = privCellCoord(box.min[1]), maxY = privCellCoord(box.max[1]);
+		const int minZ = privCellCoord(box.min[2]), maxZ = privCellCoord(box.max[2]);
+
+		for (int x = minX; x <= maxX; x++)
+		{
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int z = minZ; z <= maxZ; z++)
+				{
+					CellEntry entry;
+					entry.block = i;
+					entry.cell[0] = x;
+					entry.cell[1] = y;
+					entry.cell[2] = z;
+					entries.push_back(entry);
+				}
+			}
+		}
+	}
+
+	const int numEntries = (int)entries.size();
+	if (numEntries == 0) return;
+
+	// Table with at least twice as many buckets as entries (power of two so we can mask)
+	unsigned int numBuckets = 16;
+	while (numBuckets < 2u * (unsigned int)numEntries) numBuckets <<= 1;
+	bucketMask = numBuckets - 1;
+
+	// Counting sort entries by bucket
+	bucketStart.assign(numBuckets + 1, 0);
+	entryBuckets.resize(numEntries);
+	for (int e = 0; e < numEntries; e++)
+	{
+		entryBuckets[e] = privHash(entries[e].cell[0], entries[e].cell[1], entries[e].cell[2]);
+		bucketStart[entryBuckets[e] + 1]++;
+	}
+	for (unsigned int b = 0; b < numBuckets; b++)
+	{
+		bucketStart[b + 1] += bucketStart[b];
+	}
+
+	sortedEntries.resize(numEntries);
+	for (int e = 0; e < numEntries; e++)
+	{
+		sortedEntries[bucketStart[entryBuckets[e]]++] = entries[e];
+	}
+
+	// Pair up blocks sharing a cell
+	// The sort left bucketStart[b] pointing at the end of bucket b
+	for (unsigned int bucket = 0; bucket < numBuckets; bucket++)
+	{
+		const int bucketBegin = (bucket == 0) ? 0 : bucketStart[bucket - 1];
+		const int bucketEnd = bucketStart[bucket];
+
+		for (int a = bucketBegin; a < bucketEnd; a++)
+		{
+			const CellEntry& one = sortedEntries[a];
+			for (int b = a + 1; b < bucketEnd; b++)
+			{
+				const CellEntry& two = sortedEntries[b];
+
+				// Different cells can share a bucket
+				if (one.cell[0] != two.cell[0] || one.cell[1] != two.cell[1] || one.cell[2] != two.cell[2]) continue;
+
+				const AABB& boxOne = bounds[one.block];
+				const AABB& boxTwo = bounds[two.block];
+				if (!AABBOverlap(boxOne, boxTwo)) continue;
+
+				// Blocks can share several cells - only report the pair from the cell
+				// holding the min corner of their overlap
+				if (privCellCoord(std::max(boxOne.min[0], boxTwo.min[0])) != one.cell[0] ||
+					privCellCoord(std::max(boxOne.min[1], boxTwo.min[1])) != one.cell[1] ||
+					privCellCoord(std::max(boxOne.min[2], boxTwo.min[2])) != one.cell[2])
+				{
+					continue;
+				}
+
+				BlockPair pair;
+				pair.one = one.block < two.block ? one.block : two.block;
+				pair.two = one.block < two.block ? two.block : one.block;
+				pairs.push_back(pair);
+			}
+		}
+	}
+
+	std::sort(pairs.begin(), pairs.end(), BlockPairLess);
+};
+
+// Pairs found by the last update, in brute force loop order
+const std::vector<BlockPair>& SpatialHashGrid::GetPairs() const
+{
+	return pairs;
+};
+
+// Size of one cell along each axis
+float SpatialHashGrid::GetCellSize() const
+{
+	return cellSize;
+};
@@ -0,0 +1,55 @@
+#ifndef SPATIAL_HASH_GRID_H
+#define SPATIAL_HASH_GRID_H
+
+#include <vector>
+#include "Broadphase.h"
+#include "BlockPool.h"
+
+// Uniform grid broadphase, stored as a hash table so it can cover any area
+// Cells are as big as the largest brick, so each brick only lands in a handful of them.
+// Only bricks sharing a cell are paired up. Works best when bricks are all about the same size.
+class SpatialHashGrid
+{
+public:
+	SpatialHashGrid();
+	~SpatialHashGrid();
+
+	// Recompute the cell size next update (call when the blocks are replaced)
+	void Reset();
+
+	// Bin all active blocks and find pairs whose bounds overlap
+	void Update(const BlockPool& blocksIn);
+
+	// Pairs found by the last update, in brute force loop order
+	const std::vector<BlockPair>& GetPairs() const;
+
+	// Size of one cell along each axis
+	float GetCellSize() const;
+
+private:
+	// One block's entry in one cell
+	struct CellEntry
+	{
+		int		block;
+		int		cell[3];
+	};
+
+	// Which cell a coordinate falls into
+	int privCellCoord(const float valueIn) const;
+
+	// Which hash bucket a cell lands in
+	unsigned int privHash(const int xIn, const int yIn, const int zIn) const;
+
+	std::vector<AABB>			bounds;
+	std::vector<CellEntry>		entries;
+	std::vector<CellEntry>		sortedEntries;
+	std::vector<unsigned int>	entryBuckets;
+	std::vector<int>			bucketStart;
+	std::vector<BlockPair>		pairs;
+	float						cellSize;
+	float						invCellSize;
+	unsigned int				bucketMask;
+	int							numBlocks;
+};
+
+#endif
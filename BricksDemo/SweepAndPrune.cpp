@@ -0,0 +1,172 @@
+#include "SweepAndPrune.h"
+#include <algorithm>
+
+// Order endpoints by value, with starts before ends so touching boxes still pair up
+static inline bool endpointLess(float valueOne, bool minOne, float valueTwo, bool minTwo)
+{
+	return valueOne < valueTwo || (valueOne == valueTwo && minOne && !minTwo);
+};
+
+// Constructor
+SweepAndPrune::SweepAndPrune()
+	:	endpoints(), bounds(), open(), openIndex(), pairs(), axis(0), numBlocks(-1)
+{
+};
+
+// Destructor
+SweepAndPrune::~SweepAndPrune()
+{
+};
+
+// Throw away the sorted order (call when the blocks are replaced)
+void SweepAndPrune::Reset()
+{
+	numBlocks = -1;
+};
+
+// Build and fully sort the endpoint list, picking the axis with the most spread
+void SweepAndPrune::privRebuild(const BlockPool& blocksIn)
+{
+	const BodyStore& store = blocksIn.Store();
+	numBlocks = blocksIn.Count();
+
+	// Variance of block centers on each axis
+	float sum[3] = { 0.0f, 0.0f, 0.0f };
+	float sumSqr[3] = { 0.0f, 0.0f, 0.0f };
+	for (int i = 0; i < numBlocks; i++)
+	{
+		for (int k = 0; k < 3; k++)
+		{
+			const float center = store.position[i][k];
+			sum[k] += center;
+			sumSqr[k] += center * center;
+		}
+	}
+
+	axis = 0;
+	float bestVariance = -1.0f;
+	for (int k = 0; k < 3; k++)
+	{
+		const float mean = numBlocks > 0 ? sum[k] / float(numBlocks) : 0.0f;
+		const float variance = numBlocks > 0 ? sumSqr[k] / float(numBlocks) - mean * mean : 0.0f;
+		if (variance > bestVariance)
+		{
+			bestVariance = variance;
+			axis = k;
+		}
+	}
+
+	// Two endpoints per block
+	endpoints.resize(2 * numBlocks);
+	for (int i = 0; i < numBlocks; i++)
+	{
+		endpoints[2 * i].block = i;
+		endpoints[2 * i].isMin = true;
+		endpoints[2 * i + 1].block = i;
+		endpoints[2 * i + 1].isMin = false;
+	}
+
+	bounds.resize(numBlocks);
+	openIndex.resize(numBlocks);
+	for (int i = 0; i < numBlocks; i++)
+	{
+		CalcBodyAABB(store, i, bounds[i]);
+	}
+	for (size_t e = 0; e < endpoints.size(); e++)
+	{
+		const AABB& box = bounds[endpoints[e].block];
+		endpoints[e].value = endpoints[e].isMin ? box.min[axis] : box.max[axis];
+	}
+
+	std::sort(endpoints.begin(), endpoints.end(), [](const Endpoint& a, const Endpoint& b)
+	{
+		return endpointLess(a.value, a.isMin, b.value, b.isMin);
+	});
+};
+
+// Refresh bounds, re-sort, and find all pairs of active blocks whose bounds overlap
+void SweepAndPrune::Update(const BlockPool& blocksIn)
+{
+	const BodyStore& store = blocksIn.Store();
+	pairs.clear();
+
+	if (numBlocks != blocksIn.Count())
+	{
+		this->privRebuild(blocksIn);
+	}
+	else
+	{
+		// New bounds for this frame
+		for (int i = 0; i < numBlocks; i++)
+		{
+			CalcBodyAABB(store, i, bounds[i]);
+		}
+		for (size_t e = 0; e < endpoints.size(); e++)
+		{
+			const AABB& box = bounds[endpoints[e].block];
+			endpoints[e].value = endpoints[e].isMin ? box.min[axis] : box.max[axis];
+		}
+
+		// Insertion sort - the list was sorted last frame, so only a few endpoints move
+		const int numEndpoints = (int)endpoints.size();
+		for (int e = 1; e < numEndpoints; e++)
+		{
+			const Endpoint current = endpoints[e];
+			int f = e - 1;
+			while (f >= 0 && endpointLess(current.value, current.isMin, endpoints[f].value, endpoints[f].isMin))
+			{
+				endpoints[f + 1] = endpoints[f];
+				f--;
+			}
+			endpoints[f + 1] = current;
+		}
+	}
+
+	// Sweep along the axis, keeping a list of boxes we're currently inside
+	const int otherOne = (axis + 1) % 3;
+	const int otherTwo = (axis + 2) % 3;
+	open.clear();
+
+	for (size_t e = 0; e < endpoints.size(); e++)
+	{
+		const int block = endpoints[e].block;
+		if (!store.flags[block].active) continue;
+
+		if (endpoints[e].isMin)
+		{
+			// Everything still open overlaps this box on the sort axis, check the other two
+			const AABB& box = bounds[block];
+			for (size_t o = 0; o < open.size(); o++)
+			{
+				const AABB& other = bounds[open[o]];
+				if (box.min[otherOne] <= other.max[otherOne] && other.min[otherOne] <= box.max[otherOne] &&
+					box.min[otherTwo] <= other.max[otherTwo] && other.min[otherTwo] <= box.max[otherTwo])
+				{
+					BlockPair pair;
+					pair.one = block < open[o] ? block : open[o];
+					pair.two = block < open[o] ? open[o] : block;
+					pairs.push_back(pair);
+				}
+			}
+
+			openIndex[block] = (int)open.size();
+			open.push_back(block);
+		}
+		else
+		{
+			// Swap the last open box into this one's slot
+			const int slot = openIndex[block];
+			open[slot] = open.back();
+			openIndex[open[slot]] = slot;
+			open.pop_back();
+		}
+	}
+
+	std::sort(pairs.begin(), pairs.end(), BlockPairLess);
+};
+
+// Pairs found by the last update, in brute force loop order
+const std::vector<BlockPair>& SweepAndPrune::GetPairs() const
+{
+	return pairs;
+};
@@ -0,0 +1,48 @@
+#ifndef SWEEP_AND_PRUNE_H
+#define SWEEP_AND_PRUNE_H
+
+#include <vector>
+#include "Broadphase.h"
+#include "BlockPool.h"
+
+// Sweep and prune broadphase
+// Keeps the box endpoints on one axis sorted between frames. Blocks only move a little each step,
+// so an insertion sort over the nearly sorted list is close to linear. A sweep over the sorted
+// endpoints then gives the pairs overlapping on that axis, which are checked on the other two.
+class SweepAndPrune
+{
+public:
+	SweepAndPrune();
+	~SweepAndPrune();
+
+	// Throw away the sorted order (call when the blocks are replaced)
+	void Reset();
+
+	// Refresh bounds, re-sort, and find all pairs of active blocks whose bounds overlap
+	void Update(const BlockPool& blocksIn);
+
+	// Pairs found by the last update, in brute force loop order
+	const std::vector<BlockPair>& GetPairs() const;
+
+private:
+	// Start or end of a block's bounds on the sort axis
+	struct Endpoint
+	{
+		float	value;
+		int		block;
+		bool	isMin;
+	};
+
+	// Build and fully sort the endpoint list, picking the axis with the most spread
+	void privRebuild(const BlockPool& blocksIn);
+
+	std::vector<Endpoint>		endpoints;
+	std::vector<AABB>			bounds;
+	std::vector<int>			open;
+	std::vector<int>			openIndex;
+	std::vector<BlockPair>		pairs;
+	int							axis;
+	int							numBlocks;
+};
+
+#endif
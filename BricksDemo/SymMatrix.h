@@ -0,0 +1,161 @@
+#ifndef MATH_SYM_MATRIX_H
+#define MATH_SYM_MATRIX_H
+
+#include "Vect.h"
+#include "Matrix.h"
+
+// Symmetric 3x3 matrix, stored as its 6 unique elements (24 bytes instead of a 64 byte Matrix)
+// Used for inertia tensors, which are always symmetric and never need a w row or column
+// Follows the Matrix conventions: vectors are rows, so v * S sums v's components times S's rows
+class SymMatrix
+{
+public:
+	// Constructors (copy, assignment and destructor are the compiler's trivial ones)
+	MATH_CONSTEXPR SymMatrix()
+		: _xx(0.0f), _xy(0.0f), _xz(0.0f), _yy(0.0f), _yz(0.0f), _zz(0.0f)
+	{
+	}
+
+	MATH_CONSTEXPR SymMatrix(const float xxIn, const float xyIn, const float xzIn, const float yyIn, const float yzIn, const float zzIn)
+		: _xx(xxIn), _xy(xyIn), _xz(xzIn), _yy(yyIn), _yz(yzIn), _zz(zzIn)
+	{
+	}
+
+	// Zero, identity, and diagonal matrices
+	static MATH_CONSTEXPR SymMatrix zero()
+	{
+		return SymMatrix();
+	}
+
+	static MATH_CONSTEXPR SymMatrix identity()
+	{
+		return SymMatrix(1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f);
+	}
+
+	static MATH_CONSTEXPR SymMatrix diagonal(const float xxIn, const float yyIn, const float zzIn)
+	{
+		return SymMatrix(xxIn, 0.0f, 0.0f, yyIn, 0.0f, zzIn);
+	}
+
+	// Set function
+	void set(const float xxIn, const float xyIn, const float xzIn, const float yyIn, const float yzIn, const float zzIn);
+
+	// Returns inverse (this object not modified) - diagonal matrices skip straight to 1 / each element
+	SymMatrix getInv() const;
+
+	// Similarity transform R * S * R^T, e.g. a body space inertia tensor into world space
+	// Only the upper triangle is worked out, since the result is symmetric too
+	SymMatrix getRotated(const Matrix& rotationIn) const;
+
+	// Same, as a full 4x4 matrix (w row and column from the identity)
+	Matrix getMatrix() const;
+
+	// Elements, upper triangle row by row
+	union
+	{
+		float _m[6];
+
+		struct
+		{
+			float _xx;
+			float _xy;
+			float _xz;
+			float _yy;
+			float _yz;
+			float _zz;
+		};
+	};
+};
+
+// Set function
+inline void SymMatrix::set(const float xxIn, const float xyIn, const float xzIn, const float yyIn, const float yzIn, const float zzIn)
+{
+	this->_xx = xxIn;
+	this->_xy = xyIn;
+	this->_xz = xzIn;
+	this->_yy = yyIn;
+	this->_yz = yzIn;
+	this->_zz = zzIn;
+};
+
+// Returns inverse (this object not modified)
+inline SymMatrix SymMatrix::getInv() const
+{
+	// Diagonal (every box's body space inertia) - no determinant needed
+	if (this->_xy == 0.0f && this->_xz == 0.0f && this->_yz == 0.0f)
+	{
+		return SymMatrix::diagonal(1.0f / this->_xx, 1.0f / this->_yy, 1.0f / this->_zz);
+	}
+
+	// Otherwise the adjugate over the determinant, which is symmetric as well
+	const float cxx = this->_yy * this->_zz - this->_yz * this->_yz;
+	const float cxy = this->_xz * this->_yz - this->_xy * this->_zz;
+	const float cxz = this->_xy * this->_yz - this->_xz * this->_yy;
+	const float cyy = this->_xx * this->_zz - this->_xz * this->_xz;
+	const float cyz = this->_xy * this->_xz - this->_xx * this->_yz;
+	const float czz = this->_xx * this->_yy - this->_xy * this->_xy;
+
+	const float det = this->_xx * cxx + this->_xy * cxy + this->_xz * cxz;
+	assert(det != 0.0f);
+	const float invDet = 1.0f / det;
+
+	return SymMatrix(cxx * invDet, cxy * invDet, cxz * invDet, cyy * invDet, cyz * invDet, czz * invDet);
+};
+
+// Similarity transform R * S * R^T
+inline SymMatrix SymMatrix::getRotated(const Matrix& rotationIn) const
+{
+	// Rows of R * S, then each element of the result is one of those rows dotted with a row of R
+	const Vect a0 = rotationIn.v[0] * *this;
+	const Vect a1 = rotationIn.v[1] * *this;
+	const Vect a2 = rotationIn.v[2] * *this;
+
+	return SymMatrix(a0.dot(rotationIn.v[0]), a0.dot(rotationIn.v[1]), a0.dot(rotationIn.v[2]),
+		a1.dot(rotationIn.v[1]), a1.dot(rotationIn.v[2]),
+		a2.dot(rotationIn.v[2]));
+};
+
+// Full 4x4 matrix
+inline Matrix SymMatrix::getMatrix() const
+{
+	return Matrix(Vect(this->_xx, this->_xy, this->_xz, 0.0f),
+		Vect(this->_xy, this->_yy, this->_yz, 0.0f),
+		Vect(this->_xz, this->_yz, this->_zz, 0.0f),
+		Vect(0.0f, 0.0f, 0.0f, 1.0f));
+};
+
+// Multiplication by symmetric matrix (w comes back as 1)
+inline Vect Vect::operator*(const SymMatrix& matrixIn) const
+{
+	Vect returnVect;
+
+#if MATH_SIMD
+	// Rows of the full matrix out of the packed elements: (xx, xy, xz), (xy, yy, yz), (xz, yz, zz)
+	const __m128 low = _mm_loadu_ps(&matrixIn._m[0]);
+	const __m128 high = _mm_loadu_ps(&matrixIn._m[2]);
+	const __m128 row1 = _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 2, 3, 1));
+	const __m128 row2 = MATH_SHUFFLE(high, 0, 2, 3, 3);
+
+	const __m128 a = _mm_loadu_ps(this->v);
+	__m128 r = _mm_mul_ps(MATH_SHUFFLE(a, 0, 0, 0, 0), low);
+	r = _mm_add_ps(r, _mm_mul_ps(MATH_SHUFFLE(a, 1, 1, 1, 1), row1));
+	r = _mm_add_ps(r, _mm_mul_ps(MATH_SHUFFLE(a, 2, 2, 2, 2), row2));
+	_mm_storeu_ps(returnVect.v, simdSetWOne(r));
+#else
+	returnVect.vx = this->vx * matrixIn._xx + this->vy * matrixIn._xy + this->vz * matrixIn._xz;
+	returnVect.vy = this->vx * matrixIn._xy + this->vy * matrixIn._yy + this->vz * matrixIn._yz;
+	returnVect.vz = this->vx * matrixIn._xz + this->vy * matrixIn._yz + this->vz * matrixIn._zz;
+	returnVect.vw = 1.0f;
+#endif
+
+	return returnVect;
+}
+
+// Multiplication by symmetric matrix (*=)
+inline Vect& Vect::operator*=(const SymMatrix& matrixIn)
+{
+	*this = *this * matrixIn;
+	return *this;
+}
+
+#endif
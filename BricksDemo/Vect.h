@@ -1,25 +1,39 @@
 #ifndef MATH_VECT_H
 #define MATH_VECT_H
 
+#include <math.h>
+#include <assert.h>
+#include "MathSIMD.h"
+
 #define MATH_PI 3.1415926535f
 
 class Matrix;
+class SymMatrix;
+class Vect3;
 
-class Vect
+// 16 byte aligned so the SIMD code can treat it as one register
+class MATH_ALIGN16 Vect
 {
 public:
-	// Constructors
-	Vect();
-	Vect(const float inX, const float inY, const float inZ, const float inW = 1.0f);
-	Vect(const Vect& vectIn);
+	friend class Matrix;
+	friend class Vect3;
 
-public:
+	// Constructors (copy, assignment and destructor are the compiler's trivial ones)
+	MATH_CONSTEXPR Vect()
+		: vx(0.0f), vy(0.0f), vz(0.0f), vw(1.0f)
+	{
+	}
 
-	// Destructor
-	~Vect() { }
+	MATH_CONSTEXPR Vect(const float inX, const float inY, const float inZ, const float inW = 1.0f)
+		: vx(inX), vy(inY), vz(inZ), vw(inW)
+	{
+	}
 
-	// Assignment Operator
-	Vect& operator=(const Vect& rhs);
+	// Zero vector (w = 1 like every other point)
+	static MATH_CONSTEXPR Vect zero()
+	{
+		return Vect(0.0f, 0.0f, 0.0f, 1.0f);
+	}
 
 	// Set functions
 	void set(const float inX, const float inY, const float inZ, const float inW = 1.0f);
@@ -44,6 +58,10 @@ public:
 	Vect operator*(const Matrix& matrixIn) const;
 	Vect& operator*=(const Matrix& matrixIn);
 
+	// Multiplication by SymMatrix (defined in SymMatrix.h)
+	Vect operator*(const SymMatrix& matrixIn) const;
+	Vect& operator*=(const SymMatrix& matrixIn);
+
 	// Special vector functions
 	float dot(const Vect& vectIn) const;
 	Vect cross(const Vect& vectIn) const;
@@ -52,6 +70,18 @@ public:
 	float mag() const;
 	float magSqr() const;
 
+	// Fast approximate versions of norm, getNorm and mag, using simdRsqrt (relative error under 5e-7)
+	// Without SIMD they're the precise versions
+	void normFast();
+	Vect getNormFast() const;
+	float magFast() const;
+
+	// normFast on each vector of an array, 4 at a time
+	static void normFastArray(Vect* vectsInOut, const int countIn);
+
+	// a if chooseA is set, b if not - picked with a mask rather than a branch
+	static Vect select(const bool chooseA, const Vect& a, const Vect& b);
+
 	bool isZero(const float tolerance = 0.0001f) const;
 	bool isEqual(const Vect& vectIn, const float tolerance = 0.0001f) const;
 
@@ -70,5 +100,346 @@ private:
 	};
 };
 
+// Set function for 4 floats
+inline void Vect::set(const float inX, const float inY, const float inZ, const float inW)
+{
+    this->vx = inX;
+    this->vy = inY;
+    this->vz = inZ;
+    this->vw = inW;
+}
+
+// Set function for another Vect
+inline void Vect::set(const Vect& rhs)
+{
+    if (this != &rhs)
+	{
+        this->vx = rhs.vx;
+        this->vy = rhs.vy;
+        this->vz = rhs.vz;
+        this->vw = rhs.vw;
+	}
+}
+
+// Indexing for modifying
+inline float& Vect::operator[](const unsigned int indexIn)
+{
+	assert(indexIn >= 0 && indexIn <= 3);
+
+	return this->v[indexIn];
+}
+
+// Constant indexing
+inline const float Vect::operator[](const unsigned int indexIn) const
+{
+	assert(indexIn >= 0 && indexIn <= 3);
+
+	return this->v[indexIn];
+}
+
+// Addition
+inline Vect Vect::operator+(const Vect& vectIn) const
+{
+#if MATH_SIMD
+    Vect returnVect;
+    _mm_storeu_ps(returnVect.v, simdSetWOne(_mm_add_ps(_mm_loadu_ps(this->v), _mm_loadu_ps(vectIn.v))));
+    return returnVect;
+#else
+    return Vect(this->vx + vectIn.vx, this->vy + vectIn.vy, this->vz + vectIn.vz);
+#endif
+}
+
+// Addition (+=)
+inline Vect& Vect::operator+=(const Vect& vectIn)
+{
+#if MATH_SIMD
+    _mm_storeu_ps(this->v, simdSetWOne(_mm_add_ps(_mm_loadu_ps(this->v), _mm_loadu_ps(vectIn.v))));
+#else
+    this->vx += vectIn.vx;
+    this->vy += vectIn.vy;
+    this->vz += vectIn.vz;
+    this->vw = 1.0f;
+#endif
+    return *this;
+}
+
+// Subtraction
+inline Vect Vect::operator-(const Vect& vectIn) const
+{
+#if MATH_SIMD
+    Vect returnVect;
+    _mm_storeu_ps(returnVect.v, simdSetWOne(_mm_sub_ps(_mm_loadu_ps(this->v), _mm_loadu_ps(vectIn.v))));
+    return returnVect;
+#else
+    return Vect(this->vx - vectIn.vx, this->vy - vectIn.vy, this->vz - vectIn.vz);
+#endif
+}
+
+// Subtraction (-=)
+inline Vect& Vect::operator-=(const Vect& vectIn)
+{
+#if MATH_SIMD
+    _mm_storeu_ps(this->v, simdSetWOne(_mm_sub_ps(_mm_loadu_ps(this->v), _mm_loadu_ps(vectIn.v))));
+#else
+    this->vx -= vectIn.vx;
+    this->vy -= vectIn.vy;
+    this->vz -= vectIn.vz;
+    this->vw = 1.0f;
+#endif
+    return *this;
+}
+
+// Multiplication by float (friend function)
+inline Vect operator*(const float s, const Vect& vectIn)
+{
+#if MATH_SIMD
+    Vect returnVect;
+    _mm_storeu_ps(returnVect.v, simdSetWOne(_mm_mul_ps(_mm_set1_ps(s), _mm_loadu_ps(vectIn.v))));
+    return returnVect;
+#else
+    return Vect(s * vectIn.vx, s * vectIn.vy, s * vectIn.vz);
+#endif
+}
+
+// Multiplication by float
+inline Vect Vect::operator*(const float s) const
+{
+#if MATH_SIMD
+    Vect returnVect;
+    _mm_storeu_ps(returnVect.v, simdSetWOne(_mm_mul_ps(_mm_set1_ps(s), _mm_loadu_ps(this->v))));
+    return returnVect;
+#else
+    return Vect(s * this->vx, s * this->vy, s * this->vz);
+#endif
+}
+
+// Multiplication by float (*=)
+inline Vect& Vect::operator*=(const float s)
+{
+#if MATH_SIMD
+    _mm_storeu_ps(this->v, simdSetWOne(_mm_mul_ps(_mm_loadu_ps(this->v), _mm_set1_ps(s))));
+#else
+    this->vx *= s;
+    this->vy *= s;
+    this->vz *= s;
+    this->vw = 1.0f;
+#endif
+    return *this;
+}
+
+// Dot product
+inline float Vect::dot(const Vect& vectIn) const
+{
+#if MATH_SIMD
+    return simdDot3(_mm_loadu_ps(this->v), _mm_loadu_ps(vectIn.v));
+#else
+    return this->vx * vectIn.vx + this->vy * vectIn.vy + this->vz * vectIn.vz;
+#endif
+}
+
+// Cross product
+inline Vect Vect::cross(const Vect& vectIn) const
+{
+#if MATH_SIMD
+    // a.yzx * b.zxy - a.zxy * b.yzx (same products and signs as the scalar version)
+    const __m128 a = _mm_loadu_ps(this->v);
+    const __m128 b = _mm_loadu_ps(vectIn.v);
+    const __m128 r = _mm_sub_ps(
+        _mm_mul_ps(MATH_SHUFFLE(a, 1, 2, 0, 3), MATH_SHUFFLE(b, 2, 0, 1, 3)),
+        _mm_mul_ps(MATH_SHUFFLE(a, 2, 0, 1, 3), MATH_SHUFFLE(b, 1, 2, 0, 3)));
+
+    Vect returnVect;
+    _mm_storeu_ps(returnVect.v, simdSetWOne(r));
+    return returnVect;
+#else
+    return Vect(this->vy * vectIn.vz - vectIn.vy * this->vz,
+        -(this->vx * vectIn.vz - vectIn.vx * this->vz),
+        this->vx * vectIn.vy - vectIn.vx * this->vy);
+#endif
+}
+
+// Normalize (modifies the vector)
+inline void Vect::norm()
+{
+#if MATH_SIMD
+    const __m128 a = _mm_loadu_ps(this->v);
+    const float f = 1 / sqrtf(simdDot3(a, a));
+    _mm_storeu_ps(this->v, simdSetWOne(_mm_mul_ps(a, _mm_set1_ps(f))));
+#else
+    float f = 1 / sqrtf(this->vx * this->vx + this->vy * this->vy + this->vz * this->vz);
+
+    this->vx *= f;
+    this->vy *= f;
+    this->vz *= f;
+    this->vw = 1.0f;
+#endif
+}
+
+// Returns normalized vector (this object not modified)
+inline Vect Vect::getNorm() const
+{
+    Vect returnVect;
+
+#if MATH_SIMD
+    const __m128 a = _mm_loadu_ps(this->v);
+    const float f = 1 / sqrtf(simdDot3(a, a));
+    _mm_storeu_ps(returnVect.v, simdSetWOne(_mm_mul_ps(a, _mm_set1_ps(f))));
+#else
+    float f = 1 / sqrtf(this->vx * this->vx + this->vy * this->vy + this->vz * this->vz);
+
+    returnVect.vx = this->vx * f;
+    returnVect.vy = this->vy * f;
+    returnVect.vz = this->vz * f;
+#endif
+
+    return returnVect;
+}
+
+// Magnitude of a vector
+inline float Vect::mag() const
+{
+#if MATH_SIMD
+    const __m128 a = _mm_loadu_ps(this->v);
+    return sqrtf(simdDot3(a, a));
+#else
+    return sqrtf(this->vx * this->vx + this->vy * this->vy + this->vz * this->vz);
+#endif
+}
+
+// Fast approximate normalize (modifies the vector)
+inline void Vect::normFast()
+{
+#if MATH_SIMD
+    const __m128 a = _mm_loadu_ps(this->v);
+    const __m128 f = simdRsqrt(_mm_set1_ps(simdDot3(a, a)));
+    _mm_storeu_ps(this->v, simdSetWOne(_mm_mul_ps(a, f)));
+#else
+    this->norm();
+#endif
+}
+
+// Fast approximate normalized vector (this object not modified)
+inline Vect Vect::getNormFast() const
+{
+    Vect returnVect(*this);
+    returnVect.normFast();
+    return returnVect;
+}
+
+// Fast approximate magnitude
+inline float Vect::magFast() const
+{
+#if MATH_SIMD
+    // |v|^2 * 1 / |v|, with zero length kept at zero instead of 0 * infinity
+    const __m128 a = _mm_loadu_ps(this->v);
+    const __m128 lengthSqr = _mm_set_ss(simdDot3(a, a));
+    const __m128 length = _mm_mul_ss(lengthSqr, simdRsqrt(lengthSqr));
+    return _mm_cvtss_f32(_mm_and_ps(length, _mm_cmpgt_ss(lengthSqr, _mm_setzero_ps())));
+#else
+    return this->mag();
+#endif
+}
+
+// normFast on each vector of an array
+inline void Vect::normFastArray(Vect* vectsInOut, const int countIn)
+{
+    int i = 0;
+
+#if MATH_SIMD
+    for (; i + 4 <= countIn; i += 4)
+    {
+        const __m128 a0 = _mm_loadu_ps(vectsInOut[i].v);
+        const __m128 a1 = _mm_loadu_ps(vectsInOut[i + 1].v);
+        const __m128 a2 = _mm_loadu_ps(vectsInOut[i + 2].v);
+        const __m128 a3 = _mm_loadu_ps(vectsInOut[i + 3].v);
+
+        // Transpose to get the x's, y's and z's together, so 4 lengths come out of one set of multiplies
+        __m128 x = a0;
+        __m128 y = a1;
+        __m128 z = a2;
+        __m128 w = a3;
+        _MM_TRANSPOSE4_PS(x, y, z, w);
+
+        const __m128 lengthSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+        const __m128 f = simdRsqrt(lengthSqr);
+
+        _mm_storeu_ps(vectsInOut[i].v, simdSetWOne(_mm_mul_ps(a0, MATH_SHUFFLE(f, 0, 0, 0, 0))));
+        _mm_storeu_ps(vectsInOut[i + 1].v, simdSetWOne(_mm_mul_ps(a1, MATH_SHUFFLE(f, 1, 1, 1, 1))));
+        _mm_storeu_ps(vectsInOut[i + 2].v, simdSetWOne(_mm_mul_ps(a2, MATH_SHUFFLE(f, 2, 2, 2, 2))));
+        _mm_storeu_ps(vectsInOut[i + 3].v, simdSetWOne(_mm_mul_ps(a3, MATH_SHUFFLE(f, 3, 3, 3, 3))));
+    }
+#endif
+
+    // Leftovers
+    for (; i < countIn; i++)
+    {
+        vectsInOut[i].normFast();
+    }
+}
+
+// Magnitude of the vector squared (avoids square root)
+inline float Vect::magSqr() const
+{
+#if MATH_SIMD
+    const __m128 a = _mm_loadu_ps(this->v);
+    return simdDot3(a, a);
+#else
+    return this->vx * this->vx + this->vy * this->vy + this->vz * this->vz;
+#endif
+}
+
+// Pick one of two vectors with a mask
+inline Vect Vect::select(const bool chooseA, const Vect& a, const Vect& b)
+{
+    Vect returnVect;
+#if MATH_SIMD
+    const __m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-(int)chooseA));
+    _mm_storeu_ps(returnVect.v, _mm_or_ps(_mm_and_ps(mask, _mm_loadu_ps(a.v)), _mm_andnot_ps(mask, _mm_loadu_ps(b.v))));
+#else
+    returnVect = chooseA ? a : b;
+#endif
+    return returnVect;
+}
+
+// Check if vector is zero vector (within tolerance)
+inline bool Vect::isZero(const float tolerance /*= 0.0001f*/) const
+{
+#if MATH_SIMD
+	// |v| <= tolerance in x, y, and z
+	const __m128 inside = _mm_cmple_ps(simdAbs(_mm_loadu_ps(this->v)), _mm_set1_ps(tolerance));
+	return (_mm_movemask_ps(inside) & 0x7) == 0x7;
+#else
+	bool retBool = true;
+
+	retBool &= ((this->v[0] >= -tolerance) && (this->v[0] <= tolerance));
+	retBool &= ((this->v[1] >= -tolerance) && (this->v[1] <= tolerance));
+	retBool &= ((this->v[2] >= -tolerance) && (this->v[2] <= tolerance));
+
+	return retBool;
+#endif
+}
+
+// Check if 2 vectors are equal (within tolerance)
+inline bool Vect::isEqual(const Vect& vectIn, const float tolerance /*= 0.0001f*/) const
+{
+#if MATH_SIMD
+	const __m128 diff = _mm_sub_ps(_mm_loadu_ps(this->v), _mm_loadu_ps(vectIn.v));
+	const __m128 inside = _mm_cmple_ps(simdAbs(diff), _mm_set1_ps(tolerance));
+	return (_mm_movemask_ps(inside) & 0x7) == 0x7;
+#else
+	bool retBool = true;
+
+	float tmp = 0.0f;
+
+	tmp = this->v[0] - vectIn.v[0];
+	retBool &= ((tmp >= -tolerance) && (tmp <= tolerance));
+	tmp = this->v[1] - vectIn.v[1];
+	retBool &= ((tmp >= -tolerance) && (tmp <= tolerance));
+	tmp = this->v[2] - vectIn.v[2];
+	retBool &= ((tmp >= -tolerance) && (tmp <= tolerance));
+
+	return retBool;
+#endif
+};
 
 #endif
\ No newline at end of file
@@ -0,0 +1,153 @@
+#ifndef MATH_VECT3_H
+#define MATH_VECT3_H
+
+#include "Vect.h"
+
+// Packed x, y, z (12 bytes, no w and no alignment) for storing lots of vectors - bounds arrays,
+// snapshots, anything that's mostly loaded and stored. Do the math in Vect: getVect() comes back
+// with w = 1, like the results of Vect's own operators, and storing a Vect just drops its w
+class Vect3
+{
+public:
+	// Constructors (copy, assignment and destructor are the compiler's trivial ones)
+	MATH_CONSTEXPR Vect3()
+		: vx(0.0f), vy(0.0f), vz(0.0f)
+	{
+	}
+
+	MATH_CONSTEXPR Vect3(const float inX, const float inY, const float inZ)
+		: vx(inX), vy(inY), vz(inZ)
+	{
+	}
+
+	// From a Vect (drops w), so Vect fields can be stored straight into a Vect3
+	MATH_CONSTEXPR Vect3(const Vect& vectIn)
+		: vx(vectIn.vx), vy(vectIn.vy), vz(vectIn.vz)
+	{
+	}
+
+	// Set functions
+	void set(const float inX, const float inY, const float inZ);
+	void set(const Vect& vectIn);
+
+	// Back to a Vect for math (w = 1)
+	Vect getVect() const;
+
+	// Accessors by number
+	const float operator[](const unsigned int indexIn) const;
+	float& operator[](const unsigned int indexIn);
+
+	// Whole arrays at a time, 4 vectors per 3 loads or stores
+	static void pack(const Vect* vectsIn, Vect3* vectsOut, const int countIn);
+	static void unpack(const Vect3* vectsIn, Vect* vectsOut, const int countIn);
+
+private:
+	float vx;
+	float vy;
+	float vz;
+};
+
+// Set function
+inline void Vect3::set(const float inX, const float inY, const float inZ)
+{
+	this->vx = inX;
+	this->vy = inY;
+	this->vz = inZ;
+};
+
+// Set function
+inline void Vect3::set(const Vect& vectIn)
+{
+	*this = Vect3(vectIn);
+};
+
+// Back to a Vect (w = 1)
+inline Vect Vect3::getVect() const
+{
+#if MATH_SIMD
+	// x and y in one 8 byte load, then z and w
+	const __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&this->vx);
+	const __m128 zw = _mm_unpacklo_ps(_mm_load_ss(&this->vz), _mm_set_ss(1.0f));
+
+	Vect returnVect;
+	_mm_storeu_ps(returnVect.v, _mm_movelh_ps(xy, zw));
+	return returnVect;
+#else
+	return Vect(this->vx, this->vy, this->vz, 1.0f);
+#endif
+};
+
+// Constant indexing
+inline const float Vect3::operator[](const unsigned int indexIn) const
+{
+	assert(indexIn <= 2);
+	return (&this->vx)[indexIn];
+};
+
+// Indexing for setting
+inline float& Vect3::operator[](const unsigned int indexIn)
+{
+	assert(indexIn <= 2);
+	return (&this->vx)[indexIn];
+};
+
+// Store an array of Vects packed
+inline void Vect3::pack(const Vect* vectsIn, Vect3* vectsOut, const int countIn)
+{
+	int i = 0;
+
+#if MATH_SIMD
+	for (; i + 4 <= countIn; i += 4)
+	{
+		const __m128 v0 = _mm_loadu_ps(vectsIn[i].v);
+		const __m128 v1 = _mm_loadu_ps(vectsIn[i + 1].v);
+		const __m128 v2 = _mm_loadu_ps(vectsIn[i + 2].v);
+		const __m128 v3 = _mm_loadu_ps(vectsIn[i + 3].v);
+
+		// (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+		const __m128 z0x1 = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 2, 2));
+		const __m128 z2x3 = _mm_shuffle_ps(v2, v3, _MM_SHUFFLE(0, 0, 2, 2));
+		float* out = &vectsOut[i].vx;
+		_mm_storeu_ps(out, _mm_shuffle_ps(v0, z0x1, _MM_SHUFFLE(2, 0, 1, 0)));
+		_mm_storeu_ps(out + 4, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 0, 2, 1)));
+		_mm_storeu_ps(out + 8, _mm_shuffle_ps(z2x3, v3, _MM_SHUFFLE(2, 1, 2, 0)));
+	}
+#endif
+
+	// Leftovers
+	for (; i < countIn; i++)
+	{
+		vectsOut[i].set(vectsIn[i]);
+	}
+};
+
+// Load an array of packed vectors back into Vects (w = 1)
+inline void Vect3::unpack(const Vect3* vectsIn, Vect* vectsOut, const int countIn)
+{
+	int i = 0;
+
+#if MATH_SIMD
+	for (; i + 4 <= countIn; i += 4)
+	{
+		// (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+		const float* in = &vectsIn[i].vx;
+		const __m128 l0 = _mm_loadu_ps(in);
+		const __m128 l1 = _mm_loadu_ps(in + 4);
+		const __m128 l2 = _mm_loadu_ps(in + 8);
+
+		const __m128 x1y1 = _mm_shuffle_ps(l0, l1, _MM_SHUFFLE(0, 0, 3, 3));
+		_mm_storeu_ps(vectsOut[i].v, simdSetWOne(l0));
+		_mm_storeu_ps(vectsOut[i + 1].v, simdSetWOne(_mm_shuffle_ps(x1y1, l1, _MM_SHUFFLE(1, 1, 2, 0))));
+		_mm_storeu_ps(vectsOut[i + 2].v, simdSetWOne(_mm_shuffle_ps(l1, l2, _MM_SHUFFLE(0, 0, 3, 2))));
+		_mm_storeu_ps(vectsOut[i + 3].v, simdSetWOne(MATH_SHUFFLE(l2, 1, 2, 3, 3)));
+	}
+#endif
+
+	// Leftovers
+	for (; i < countIn; i++)
+	{
+		vectsOut[i] = vectsIn[i].getVect();
+	}
+};
+
+#endif
@@ -0,0 +1,370 @@
+#include "World.h"
+#include "PhysicsContact.h"
+#include "CollisionCheck.h"
+#include "CollisionBatch.h"
+#include <stdlib.h>
+#include <assert.h>
+#include <math.h>
+#include <algorithm>
+
+// Constructor
+World::World()
+	:	bodies(), ground(bodies, bodies.Add()), bricks(), bullet(bodies, bodies.Add()),
+		sweepAndPrune(), spatialHashGrid(), aabbTree(), broadphaseMode(BROADPHASE_SWEEP_AND_PRUNE),
+		nearbyBricks(), launchBricks(), touchingPairs(), axisCache(), uncachedPairs(), useAxisCache(false), integrator(), rotationBatch(),
+		bulletHit(false)
+{
+};
+
+// Destructor
+World::~World()
+{
+};
+
+// Set up the ground, a wall of the given number of bricks, and the bullet
+void World::Reset(const int numBricksIn)
+{
+	assert(numBricksIn >= 0);
+
+	// Wall is about 6 wide for every 5 high (6 x 5 for the original 30 bricks)
+	int wallWidth = 1;
+	while (wallWidth * wallWidth * 5 < numBricksIn * 6)
+	{
+		wallWidth++;
+	}
+
+	// Setup ground, widening it if the wall wouldn't fit
+	float groundWidth = 40.0f * wallWidth;
+	if (groundWidth < 1000.0f) groundWidth = 1000.0f;
+
+	ground.Color() = Vect(0.0f, 0.4f, 0.0f, 1.0f);
+	ground.Position() = Vect(0.0f, -2.5f, 0.0f);
+	ground.Scale() = Vect(groundWidth, 5.0f, 3000.0f);
+	ground.InverseMass() = 0.0f;
+	ground.CalcInertiaTensor();
+	ground.CalculateDerivedData();
+
+	// Set the 4 colors for our bricks
+	Vect colors[4];
+	colors[0] = Vect(1.0f, 0.0f, 0.0f, 1.0f);
+	colors[1] = Vect(0.0f, 1.0f, 0.0f, 1.0f);
+	colors[2] = Vect(0.0f, 0.0f, 1.0f, 1.0f);
+	colors[3] = Vect(1.0f, 1.0f, 0.0f, 1.0f);
+
+	// Setup the bricks, all memory allocated up front
+	bricks.Clear();
+	bricks.Reserve(numBricksIn);
+	for (int index = 0; index < numBricksIn; index++)
+	{
+		int i = index / wallWidth;
+		int j = index % wallWidth;
+
+		Block* brick = bricks.Add();
+		brick->Scale() = Vect(20.0f, 20.0f, 20.f);
+		brick->Color() = colors[((j % 4) + i) % 4];
+		brick->Position() = Vect(-10.0f * (wallWidth - 1) + 20.0f * j, 10.0f + 20.0f * i, -500.0f);
+		brick->Velocity() = Vect(0.0f, 0.0f, 0.0f);
+		brick->AngVelocity() = Vect(0.0f, 0.0f, 0.0f);
+		brick->Rotation() = Quat(0.0f, 0.0f, 0.0f, 1.0f);
+		brick->InverseMass() = 0.2f;
+		brick->GravityNow() = false;
+		brick->CalcInertiaTensor();
+	}
+
+	// Setup our bullet
+	bullet.Scale() = Vect(2.0f, 2.0f, 2.f);
+	bullet.Color() = Vect(0.0f, 0.0f, 0.0f, 1.0f);
+	bullet.Position() = Vect(0.0f, 1000.0f, 0.0f);
+	bullet.InverseMass() = 0.5f;
+	bullet.GravityNow() = false;
+	bullet.GravityEver() = false;
+	bullet.Active() = false;
+	bullet.CalcInertiaTensor();
+
+	sweepAndPrune.Reset();
+	spatialHashGrid.Reset();
+	aabbTree.Reset();
+	axisCache.Reset();
+	bulletHit = false;
+};
+
+// Step all blocks forward and resolve collisions
+void World::Update(const float elapsedTime)
+{
+	bulletHit = false;
+
+	// update the ground and bullet, then our bricks
+	integrator.Integrate(bodies, elapsedTime);
+	integrator.Integrate(bricks.Store(), elapsedTime);
+
+	// Check for any collisions and handle them
+	privCheckCollisions(elapsedTime);
+};
+
+// Rotation matrix of every brick, worked out in one batch
+void World::CalcBrickRotations(std::vector<Matrix>& rotationsOut)
+{
+	const int numBricks = bricks.Count();
+	rotationsOut.resize(numBricks);
+	if (numBricks == 0) return;
+
+	const BodyStore& store = bricks.Store();
+	rotationBatch.resize(numBricks);
+	for (int i = 0; i < numBricks; i++)
+	{
+		rotationBatch.set(i, store.rotation[i]);
+	}
+
+	rotationBatch.getMatrices(&rotationsOut[0]);
+};
+
+// Launch the bullet from a position toward a target point
+void World::FireBullet(const Vect& fromIn, const Vect& targetIn)
+{
+	// Set our velocity to be toward the target point
+	bullet.Position() = fromIn;
+	bullet.Velocity() = targetIn - bullet.Position();
+	bullet.Velocity().norm();
+	bullet.Velocity() *= 1000.0f;
+	bullet.Rotation() = Quat(0.0f, 0.0f, 0.0f, 1.0f);
+	bullet.AngVelocity() = Vect(0.0f, 0.0f, 0.0f);
+	bullet.Active() = true;
+	bullet.GravityNow() = false;
+};
+
+// Whether the bullet hit a brick during the last update
+bool World::BulletHitBrick() const
+{
+	return bulletHit;
+};
+
+// Choose how we find brick pairs that might be colliding
+void World::SetBroadphase(const BroadphaseMode modeIn)
+{
+	broadphaseMode = modeIn;
+	sweepAndPrune.Reset();
+	spatialHashGrid.Reset();
+	aabbTree.Reset();
+	axisCache.Reset();
+};
+
+// Turn the separating axis cache on or off
+void World::SetAxisCache(const bool onIn)
+{
+	useAxisCache = onIn;
+	axisCache.Reset();
+};
+
+// Whether the separating axis cache is on
+bool World::GetAxisCache() const
+{
+	return useAxisCache;
+};
+
+// Get which broadphase we're using
+BroadphaseMode World::GetBroadphase() const
+{
+	return broadphaseMode;
+};
+
+// Bricks that might touch a block, in index order
+// Only the tree narrows this down, the other broadphases just handle brick pairs
+void World::privFindBricksNear(const Block& blockIn, std::vector<int>& bricksOut)
+{
+	bricksOut.clear();
+	if (!blockIn.Active()) return;
+
+	if (broadphaseMode == BROADPHASE_AABB_TREE)
+	{
+		AABB bounds;
+		CalcBlockAABB(blockIn, bounds);
+		aabbTree.Query(bounds, bricksOut);
+		std::sort(bricksOut.begin(), bricksOut.end());
+	}
+	else
+	{
+		const int numBricks = bricks.Count();
+		bricksOut.resize(numBricks);
+		for (int i = 0; i < numBricks; i++)
+		{
+			bricksOut[i] = i;
+		}
+	}
+};
+
+// Bricks that might be within a radius of a point, in index order
+void World::privFindBricksInRadius(const Vect& centerIn, const float radiusIn, std::vector<int>& bricksOut)
+{
+	bricksOut.clear();
+
+	if (broadphaseMode == BROADPHASE_AABB_TREE)
+	{
+		aabbTree.QueryRadius(centerIn, radiusIn, bricksOut);
+		std::sort(bricksOut.begin(), bricksOut.end());
+	}
+	else
+	{
+		const int numBricks = bricks.Count();
+		bricksOut.resize(numBricks);
+		for (int i = 0; i < numBricks; i++)
+		{
+			bricksOut[i] = i;
+		}
+	}
+};
+
+// Check a pair of blocks, and resolve the collision if they're touching
+void World::privCollideBlocks(Block& blockOne, Block& blockTwo, ContactManifold& manifold, PhysicsContact& contact,
+	const float timeIn, unsigned int* cachedAxisInOut /*= 0*/)
+{
+	if (CheckColliding(blockOne, blockTwo, manifold, cachedAxisInOut))
+	{
+		// Handle collision accordingly, at every point they touch on
+		contact.ResolveManifold(manifold, timeIn);
+		manifold.Reset();
+	}
+};
+
+// Check our collisions and handle them accordingly
+void World::privCheckCollisions(const float timeIn)
+{
+	ContactManifold manifold;
+	manifold.Reset();
+	PhysicsContact contact;
+	contact.Reset();
+
+	const int numBricks = bricks.Count();
+
+	// Check bullet and ground
+	privCollideBlocks(ground, bullet, manifold, contact, timeIn);
+
+	// Tree is also used for the ground and bullet checks, so bring it up to date first
+	if (broadphaseMode == BROADPHASE_AABB_TREE)
+	{
+		aabbTree.Update(bricks);
+	}
+
+	// Check all bricks against ground
+	privFindBricksNear(ground, nearbyBricks);
+	for (size_t n = 0; n < nearbyBricks.size(); n++)
+	{ 
+		privCollideBlocks(bricks[nearbyBricks[n]], ground, manifold, contact, timeIn);
+	}
+
+	// Check all bricks against bullet
+	privFindBricksNear(bullet, nearbyBricks);
+	for (size_t n = 0; n < nearbyBricks.size(); n++)
+	{ 
+		const int i = nearbyBricks[n];
+		if (CheckColliding(bullet, bricks[i], manifold))
+		{
+			// Where it hit (the deepest point)
+			const Vect hitPoint = manifold.points[0];
+
+			// Time to have some fun with all blocks within certain distance of this collision
+			// Launch those bricks upward with random angular velocity
+			const float launchRadiusSqr = 1500.0f;
+			privFindBricksInRadius(hitPoint, sqrtf(launchRadiusSqr), launchBricks);
+			for (size_t l = 0; l < launchBricks.size(); l++)
+			{
+				const int k = launchBricks[l];
+
+				// use mag squared to avoid square root
+				Vect diffPos = bricks[k].Position() - hitPoint;
+				float magSquared = diffPos.magSqr();
+				
+				if (magSquared < launchRadiusSqr && bricks[k].Position()[1] >= bricks[i].Position()[1])
+				{
+					Vect velocityChange(diffPos[0] > 0 ? 30.0f : -30.0f, 200.0f, 0.0f);
+					bricks[k].Velocity() += velocityChange;
+
+					static int x = 987444303;
+					srand(x);
+					x += 5134;
+
+					// Random angular velocity
+					Vect angVelocityChange(0.0f, 0.0f, 0.0f);
+					angVelocityChange[0] = (float)(rand() % 60 - 30);
+					angVelocityChange[1] = (float)(rand() % 60 - 30);
+					angVelocityChange[2] = (float)(rand() % 60 - 30);
+
+					bricks[k].AngVelocity() += angVelocityChange;
+				}
+			}
+
+			// Let the caller know (demo slows time on this)
+			bulletHit = true;
+			manifold.Reset();
+			bullet.Active() = false;
+			break;
+		}
+	}
+
+	// Now check bricks with each other
+	if (broadphaseMode == BROADPHASE_BRUTE_FORCE)
+	{
+		// Every pair
+		for (int i = 0; i < numBricks; i++)
+		{
+			for (int j = i + 1; j < numBricks; j++)
+			{
+				privCollideBlocks(bricks[i], bricks[j], manifold, contact, timeIn);
+			}
+		}
+	}
+	else
+	{
+		// Only the pairs whose bounds overlap
+		const std::vector<BlockPair>* pairs = 0;
+		if (broadphaseMode == BROADPHASE_HASH_GRID)
+		{
+			spatialHashGrid.Update(bricks);
+			pairs = &spatialHashGrid.GetPairs();
+		}
+		else if (broadphaseMode == BROADPHASE_AABB_TREE)
+		{
+			pairs = &aabbTree.GetPairs();
+		}
+		else
+		{
+			sweepAndPrune.Update(bricks);
+			pairs = &sweepAndPrune.GetPairs();
+		}
+
+		if (!useAxisCache)
+		{
+			// Drop the near misses a batch at a time, then check what's left in the same order
+			RejectSeparatedPairs(bricks.Store(), *pairs, touchingPairs);
+			for (size_t p = 0; p < touchingPairs.size(); p++)
+			{
+				privCollideBlocks(bricks[touchingPairs[p].one], bricks[touchingPairs[p].two], manifold, contact, timeIn);
+			}
+		}
+		else
+		{
+			// First drop the pairs still apart on the face axis that separated them last step (keeping that axis),
+			// then the near misses a batch at a time, and check what's left in the same order
+			axisCache.BeginStep((int)pairs->size());
+			uncachedPairs.clear();
+			for (size_t p = 0; p < pairs->size(); p++)
+			{
+				const BlockPair& pair = (*pairs)[p];
+				const unsigned int axis = axisCache.Get(pair.one, pair.two);
+				if (SeparatedOnFaceAxis(bricks[pair.one], bricks[pair.two], axis)) axisCache.Set(pair.one, pair.two, axis);
+				else uncachedPairs.push_back(pair);
+			}
+
+			// Boxes don't move while we resolve, so checking the pairs in two passes gives the same verdicts
+			RejectSeparatedPairs(bricks.Store(), uncachedPairs, touchingPairs);
+			for (size_t p = 0; p < touchingPairs.size(); p++)
+			{
+				const BlockPair& pair = touchingPairs[p];
+				unsigned int axis = SAT_NO_AXIS;
+				privCollideBlocks(bricks[pair.one], bricks[pair.two], manifold, contact, timeIn, &axis);
+				axisCache.Set(pair.one, pair.two, axis);
+			}
+		}
+	}
+
+	return;
+};
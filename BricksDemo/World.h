@@ -0,0 +1,96 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include "Vect.h"
+#include "Block.h"
+#include "BlockPool.h"
+#include "Broadphase.h"
+#include "SweepAndPrune.h"
+#include "SpatialHashGrid.h"
+#include "DynamicAABBTree.h"
+#include "QuatBatch.h"
+#include "BodyIntegrator.h"
+#include "SeparatingAxisCache.h"
+
+class PhysicsContact;
+struct ContactManifold;
+
+// Holds all of our physics objects and steps the simulation
+// No window or Direct3D code in here, so it can also run headless
+class World
+{
+public:
+	World();
+	~World();
+
+	// Set up the ground, a wall of the given number of bricks, and the bullet
+	void Reset(const int numBricksIn);
+
+	// Step all blocks forward and resolve collisions
+	void Update(const float elapsedTime);
+
+	// Launch the bullet from a position toward a target point
+	void FireBullet(const Vect& fromIn, const Vect& targetIn);
+
+	// Whether the bullet hit a brick during the last update
+	bool BulletHitBrick() const;
+
+	// Choose how we find brick pairs that might be colliding
+	void SetBroadphase(const BroadphaseMode modeIn);
+	BroadphaseMode GetBroadphase() const;
+
+	// Whether pairs start from last step's separating axis (off unless turned on)
+	// Pairs still apart on a face axis they were apart on last step skip the narrowphase altogether
+	void SetAxisCache(const bool onIn);
+	bool GetAxisCache() const;
+
+	// Rotation matrix of every brick (same as Matrix::set(Quat) on each), worked out in one batch for drawing
+	void CalcBrickRotations(std::vector<Matrix>& rotationsOut);
+
+	// Our physics objects - the ground and bullet are handles into bodies, the bricks into a store of their own
+	BodyStore					bodies;
+	Block						ground;
+	BlockPool					bricks;
+	Block						bullet;
+
+private:
+	// Check our collisions and handle them accordingly
+	void privCheckCollisions(const float elapsedTime);
+
+	// Bricks that might touch a block, or be within a radius of a point (in index order)
+	void privFindBricksNear(const Block& blockIn, std::vector<int>& bricksOut);
+	void privFindBricksInRadius(const Vect& centerIn, const float radiusIn, std::vector<int>& bricksOut);
+
+	// Check a pair of blocks, and resolve the collision if they're touching
+	// cachedAxisInOut is the pair's separating axis cache entry, if it has one
+	void privCollideBlocks(Block& blockOne, Block& blockTwo, ContactManifold& manifold, PhysicsContact& contact,
+		const float elapsedTime, unsigned int* cachedAxisInOut = 0);
+
+	// Broadphase structures
+	SweepAndPrune				sweepAndPrune;
+	SpatialHashGrid				spatialHashGrid;
+	DynamicAABBTree				aabbTree;
+	BroadphaseMode				broadphaseMode;
+
+	// Scratch lists of brick indices
+	std::vector<int>			nearbyBricks;
+	std::vector<int>			launchBricks;
+
+	// Broadphase pairs the batched rejection couldn't separate
+	std::vector<BlockPair>		touchingPairs;
+
+	// Each pair's last separating axis, and the pairs it couldn't separate (when it's on)
+	SeparatingAxisCache			axisCache;
+	std::vector<BlockPair>		uncachedPairs;
+	bool						useAxisCache;
+
+	// Steps each store's bodies forward in one pass
+	BodyIntegrator				integrator;
+
+	// Scratch space for the brick rotation matrices
+	QuatBatch					rotationBatch;
+
+	bool						bulletHit;
+};
+
+#endif